@@ -0,0 +1,257 @@
+//***********************************************************************************************
+//Mind Meld Modular: Modules for VCV Rack by Steve Baker and Marc Boulé
+//
+//Micro-benchmarks of the header-only filter kernels in src/dsp
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+// Build with "make bench" (see Makefile), then:
+//   ./bench/DspBench [numSamples] [output.csv]
+// Each kernel's process() and setParameters()/setFilterCutoffs() is timed per call, with three kinds of input:
+//   noise:  full scale noise, the normal case
+//   decay:  a short noise burst followed by silence, so that the filter states decay into denormals
+//   tiny:   noise scaled to the denormal range
+// and with flush-to-zero/denormals-are-zero both off and on (Rack's engine turns them on in its audio threads).
+// Results are written as CSV (kernel,method,input,ftz,ns) to stdout, or to the given file.
+
+
+#include "../src/MindMeldModular.hpp"
+#include "../src/dsp/QuattroBiQuad.hpp"
+#include "../src/dsp/ButterworthFilters.hpp"
+#include "../src/dsp/LinkwitzRileyCrossover.hpp"
+#include <chrono>
+#if defined(__SSE__) || defined(_M_X64)
+	#include <xmmintrin.h>
+	#define DSPBENCH_HAS_MXCSR
+#endif
+
+
+enum InputKinds {IN_NOISE, IN_DECAY, IN_TINY, NUM_IN_KINDS};
+static const char* inputNames[NUM_IN_KINDS] = {"noise", "decay", "tiny"};
+
+static float sink = 0.0f;// keeps the optimizer from removing the work
+
+
+static inline void escape(void* p) {
+	// makes the object's state observable, so that the coefficient calculations of setParameters() are not removed
+	asm volatile("" : : "g"(p) : "memory");
+}
+
+
+static void fillInput(std::vector<float>& buf, int kind) {
+	uint32_t state = 0x2545F491;
+	for (size_t i = 0; i < buf.size(); i++) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		float n = (float)(int32_t)state * (1.0f / 2147483648.0f);
+		if (kind == IN_NOISE) {
+			buf[i] = 5.0f * n;
+		}
+		else if (kind == IN_DECAY) {
+			buf[i] = (i % 48000) < 64 ? 5.0f * n : 0.0f;// 64 sample burst every second
+		}
+		else {
+			buf[i] = 1e-39f * n;
+		}
+	}
+}
+
+
+static void setFtz(bool ftz) {
+	#ifdef DSPBENCH_HAS_MXCSR
+	unsigned int csr = _mm_getcsr() & ~0x8040u;
+	_mm_setcsr(ftz ? (csr | 0x8040u) : csr);// FTZ (bit 15) and DAZ (bit 6)
+	#endif
+}
+
+
+template<typename F>
+static double timeNs(int64_t numCalls, F func) {
+	auto start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < numCalls; i++) {
+		func(i);
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / (double)numCalls;
+}
+
+
+struct Results {
+	FILE* file;
+
+	void add(const char* kernel, const char* method, const char* input, bool ftz, double ns) {
+		std::fprintf(file, "%s,%s,%s,%d,%.3f\n", kernel, method, input, ftz ? 1 : 0, ns);
+	}
+};
+
+
+static void benchProcess(Results& res, int64_t numSamples, const std::vector<float>* inputs, bool ftz) {
+	size_t mask = inputs[0].size() - 1;// size is a power of two
+
+	for (int k = 0; k < NUM_IN_KINDS; k++) {
+		const float* in = inputs[k].data();
+		double ns;
+
+		// QuattroBiQuad, four peaking bands with gain
+		QuattroBiQuad qbq;
+		qbq.reset();
+		for (int b = 0; b < 4; b++) {
+			qbq.setParameters(b, QuattroBiQuadCoeff::PEAK, 0.002f * (b + 1), 2.0f, 1.0f);
+		}
+		ns = timeNs(numSamples, [&](int64_t i) {
+			float stereoIn[2] = {in[i & mask], in[(i + 1) & mask]};
+			float out[2];
+			qbq.process(out, stereoIn);
+			sink += out[0];
+		});
+		res.add("QuattroBiQuad", "process", inputNames[k], ftz, ns);
+
+		// QuattroTrackBiQuad, same four bands for four tracks at once (so one call does the work of four QuattroBiQuad calls)
+		QuattroTrackBiQuad qtbq;
+		for (int t = 0; t < 4; t++) {
+			for (int b = 0; b < 4; b++) {
+				qtbq.setParameters(t, b, QuattroBiQuadCoeff::PEAK, 0.002f * (b + 1), 2.0f, 1.0f);
+			}
+		}
+		ns = timeNs(numSamples, [&](int64_t i) {
+			simd::float_4 outL;
+			simd::float_4 outR;
+			qtbq.process(&outL, &outR, simd::float_4::load(&in[i & (mask & ~0x3)]), simd::float_4::load(&in[(i + 4) & (mask & ~0x3)]));
+			sink += outL[0];
+		});
+		res.add("QuattroTrackBiQuad", "process", inputNames[k], ftz, ns);
+
+		// LinkwitzRileyStereoCrossover
+		LinkwitzRileyStereoCrossover lrx;
+		lrx.reset();
+		lrx.setFilterCutoffs(120.0f / 48000.0f, true);
+		ns = timeNs(numSamples, [&](int64_t i) {
+			sink += lrx.process(in[i & mask], in[(i + 1) & mask])[0];
+		});
+		res.add("LinkwitzRileyStereoCrossover", "process", inputNames[k], ftz, ns);
+
+		// LinkwitzRileyStereo8xCrossover, all 8 channels per sample
+		LinkwitzRileyStereo8xCrossover lrx8;
+		lrx8.reset();
+		lrx8.setFilterCutoffs(120.0f / 48000.0f, true);
+		ns = timeNs(numSamples, [&](int64_t i) {
+			for (int c = 0; c < 8; c++) {
+				sink += lrx8.process(in[(i + c) & mask], in[(i + c + 1) & mask], c)[0];
+			}
+		});
+		res.add("LinkwitzRileyStereo8xCrossover", "process", inputNames[k], ftz, ns);
+
+		// ButterworthThirdOrder (HPF in tracks)
+		ButterworthThirdOrder bw3;
+		bw3.reset();
+		bw3.setParameters(true, 40.0f / 48000.0f);
+		ns = timeNs(numSamples, [&](int64_t i) {
+			sink += bw3.process(in[i & mask]);
+		});
+		res.add("ButterworthThirdOrder", "process", inputNames[k], ftz, ns);
+
+		// ButterworthFourthOrder
+		ButterworthFourthOrder bw4;
+		bw4.reset();
+		bw4.setParameters(false, 8000.0f / 48000.0f);
+		ns = timeNs(numSamples, [&](int64_t i) {
+			sink += bw4.process(in[i & mask]);
+		});
+		res.add("ButterworthFourthOrder", "process", inputNames[k], ftz, ns);
+
+		// FirstOrderStereoFilter
+		FirstOrderStereoFilter fo;
+		fo.reset();
+		fo.setParameters(false, 1000.0f / 48000.0f);
+		ns = timeNs(numSamples, [&](int64_t i) {
+			float stereoIn[2] = {in[i & mask], in[(i + 1) & mask]};
+			float out[2];
+			fo.process(out, stereoIn);
+			sink += out[0];
+		});
+		res.add("FirstOrderStereoFilter", "process", inputNames[k], ftz, ns);
+	}
+}
+
+
+static void benchSetParameters(Results& res, int64_t numCalls, bool ftz) {
+	// frequencies are swept so that both the small-angle and the tan() pre-warp paths of the biquads are taken
+	double ns;
+
+	QuattroBiQuad qbq;
+	ns = timeNs(numCalls, [&](int64_t i) {
+		float nfc = 0.0005f + (float)(i & 0x3FF) * (0.45f / 1024.0f);
+		qbq.setParameters((int)(i & 0x3), (QuattroBiQuadCoeff::Type)(i % 3), nfc, 1.5f, 0.8f);
+		escape(&qbq);
+	});
+	res.add("QuattroBiQuad", "setParameters", "sweep", ftz, ns);
+
+	// all four bands per call, so compare with four setParameters() calls
+	static const QuattroBiQuadCoeff::Type vecTypes[4] = {QuattroBiQuadCoeff::LOWSHELF, QuattroBiQuadCoeff::PEAK, QuattroBiQuadCoeff::PEAK, QuattroBiQuadCoeff::HIGHSHELF};
+	ns = timeNs(numCalls, [&](int64_t i) {
+		float nfc = 0.0005f + (float)(i & 0x3FF) * (0.45f / 1024.0f);
+		qbq.setParametersVec(vecTypes, simd::float_4(nfc, nfc * 0.5f, nfc * 0.25f, nfc * 0.125f), simd::float_4(1.5f, 0.7f, 1.5f, 0.7f), simd::float_4(0.8f));
+		escape(&qbq);
+	});
+	res.add("QuattroBiQuad", "setParametersVec", "sweep", ftz, ns);
+
+	LinkwitzRileyStereoCrossover lrx;
+	ns = timeNs(numCalls, [&](int64_t i) {
+		lrx.setFilterCutoffs(0.0005f + (float)(i & 0x3FF) * (0.01f / 1024.0f), (i & 0x400) != 0);
+		escape(&lrx);
+	});
+	res.add("LinkwitzRileyStereoCrossover", "setFilterCutoffs", "sweep", ftz, ns);
+
+	ButterworthThirdOrder bw3;
+	ns = timeNs(numCalls, [&](int64_t i) {
+		bw3.setParameters(true, 0.0004f + (float)(i & 0x3FF) * (0.01f / 1024.0f));
+		escape(&bw3);
+	});
+	res.add("ButterworthThirdOrder", "setParameters", "sweep", ftz, ns);
+
+	ButterworthFourthOrder bw4;
+	ns = timeNs(numCalls, [&](int64_t i) {
+		bw4.setParameters(false, 0.01f + (float)(i & 0x3FF) * (0.4f / 1024.0f));
+		escape(&bw4);
+	});
+	res.add("ButterworthFourthOrder", "setParameters", "sweep", ftz, ns);
+
+	FirstOrderStereoFilter fo;
+	ns = timeNs(numCalls, [&](int64_t i) {
+		fo.setParameters((i & 0x1) != 0, 0.0004f + (float)(i & 0x3FF) * (0.4f / 1024.0f));
+		escape(&fo);
+	});
+	res.add("FirstOrderStereoFilter", "setParameters", "sweep", ftz, ns);
+}
+
+
+int main(int argc, char* argv[]) {
+	int64_t numSamples = (argc > 1 ? std::atoll(argv[1]) : 4800000);
+	Results res;
+	res.file = (argc > 2 ? std::fopen(argv[2], "w") : stdout);
+	if (!res.file) {
+		std::fprintf(stderr, "DspBench: could not open %s\n", argv[2]);
+		return 1;
+	}
+
+	std::vector<float> inputs[NUM_IN_KINDS];
+	for (int k = 0; k < NUM_IN_KINDS; k++) {
+		inputs[k].resize(1 << 16);
+		fillInput(inputs[k], k);
+	}
+
+	std::fprintf(res.file, "kernel,method,input,ftz,ns\n");
+	for (int ftz = 0; ftz < 2; ftz++) {
+		setFtz(ftz != 0);
+		benchProcess(res, numSamples, inputs, ftz != 0);
+		benchSetParameters(res, numSamples / 16, ftz != 0);
+	}
+	setFtz(false);
+
+	if (res.file != stdout) {
+		std::fclose(res.file);
+	}
+	std::fprintf(stderr, "DspBench: done (%g)\n", sink);
+	return 0;
+}
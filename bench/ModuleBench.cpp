@@ -0,0 +1,471 @@
+//***********************************************************************************************
+//Mind Meld Modular: Modules for VCV Rack by Steve Baker and Marc Boulé
+//
+//Headless benchmark: drives Module::process() of the main modules without the Rack GUI
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+// Build with "make bench" (see Makefile), run from the plugin folder so that asset::plugin() finds ./res and ./presets:
+//   ./bench/ModuleBench [numSamples] [sampleRate]
+// Output is one line per module and eco setting, in ns per sample, tab separated so it can be pasted or diffed.
+// MixMaster32 and MixMaster64 (a 64-track engine built for the bench only, see Makefile) are to be compared with 
+// the cost of 2 to 4 chained MixMasters, the main outputs of each going into the chain inputs of the next.
+// The stub engine below replaces the cables and expander flips of Rack's engine: inputs are filled directly
+// with synthetic audio and CV, outputs are marked as connected, chain cables are stepped and expander messages 
+// are flipped after each sample in the same order as Rack does it.
+// Before the timings, whole fades of updateFadeGain() are checked against std::expm1() and std::log1p() for every
+// fade profile, symmetrical or not; the exit code is 1 when one of them is off by more than 1e-6.
+// The adaptive eco of MixMaster (with AuxSpander) is then run on an idle patch and on a busy one, and the control-rate
+// dividers it picks are printed; the exit code is also 1 when the idle patch doesn't settle below 1/16.
+
+
+#include "../src/MindMeldModular.hpp"
+#include "../src/MixMaster/MixerCommon.hpp"
+#include <chrono>
+#include <algorithm>
+
+
+extern Model *modelMixMaster64;// bench only, see MixMaster.cpp
+
+
+// Kinds of synthetic signals that are sent into a module's inputs
+enum SigKinds {SIG_NONE, SIG_AUDIO, SIG_CV, SIG_GATE, SIG_CLOCK};
+
+
+struct BenchCase {
+	const char* name;
+	Model** model;
+	Model** rightExpanderModel;// NULL when no expander
+	int audioChannels;// number of poly channels in each audio input
+	int (*inputKind)(int inputId);
+	int (*expanderInputKind)(int inputId);
+	int numChained;// 1 when not chained, else number of MixMasters in the chain (no expander then)
+};
+
+
+// MixMaster with N_TRK tracks and 4 groups
+template <int N_TRK>
+static int kindMixMasterN(int inputId) {
+	if (inputId < N_TRK * 2) return SIG_AUDIO;// TRACK_SIGNAL_INPUTS
+	if (inputId < N_TRK * 2 + N_TRK + 4 + N_TRK + 4) return SIG_CV;// vol and pan cvs
+	return SIG_NONE;// chain, inserts and mute/solo cvs
+}
+static int kindMixMaster(int inputId) {
+	return kindMixMasterN<16>(inputId);
+}
+static const int MM_CHAIN_INPUTS = 16 * 2 + 16 + 4 + 16 + 4;// of the 16-track MixMaster
+static const int MM_MAIN_OUTPUTS = 16 / 8 + 1;// of the 16-track MixMaster
+static int kindAuxExpander(int inputId) {
+	if (inputId < 2 * 4) return SIG_AUDIO;// RETURN_INPUTS
+	return SIG_NONE;
+}
+static int kindEqMaster(int inputId) {
+	return SIG_AUDIO;// SIG_INPUTS
+}
+static int kindBassMaster(int inputId) {
+	return inputId < 2 ? SIG_AUDIO : SIG_CV;// IN_INPUTS then width cvs
+}
+static int kindShapeMaster(int inputId) {
+	if (inputId < 8) return SIG_AUDIO;// IN_INPUTS
+	if (inputId < 16) return SIG_NONE;// TRIG_INPUTS
+	if (inputId == 16) return SIG_CLOCK;// CLOCK_INPUT
+	if (inputId == 18) return SIG_GATE;// RUN_INPUT
+	if (inputId == 19) return SIG_AUDIO;// SIDECHAIN_INPUT
+	return SIG_NONE;
+}
+static int kindRouteMaster(int inputId) {
+	return SIG_AUDIO;// IN_INPUTS
+}
+
+
+static const BenchCase benchCases[] = {
+	{"MixMaster",         &modelMixMaster,             NULL,              1, kindMixMaster,      NULL,            1},
+	{"MixMaster+Aux",     &modelMixMaster,             &modelAuxExpander, 1, kindMixMaster,      kindAuxExpander, 1},
+	{"MixMaster32",       &modelMixMaster32,           NULL,              1, kindMixMasterN<32>, NULL,            1},
+	{"MixMaster x2",      &modelMixMaster,             NULL,              1, kindMixMaster,      NULL,            2},
+	{"MixMaster x3",      &modelMixMaster,             NULL,              1, kindMixMaster,      NULL,            3},
+	{"MixMaster64",       &modelMixMaster64,           NULL,              1, kindMixMasterN<64>, NULL,            1},
+	{"MixMaster x4",      &modelMixMaster,             NULL,              1, kindMixMaster,      NULL,            4},
+	{"EqMaster",          &modelEqMaster,              NULL,              8, kindEqMaster,       NULL,            1},
+	{"ShapeMaster",       &modelShapeMaster,           NULL,              1, kindShapeMaster,    NULL,            1},
+	{"BassMaster",        &modelBassMaster,            NULL,              1, kindBassMaster,     NULL,            1},
+	{"RouteMasterSt5to1", &modelRouteMasterStereo5to1, NULL,              1, kindRouteMaster,    NULL,            1},
+};
+
+
+struct StubEngine {
+	float sampleRate;
+	float sampleTime;
+	int64_t frame = 0;
+	std::vector<Module*> modules;
+	std::vector<int (*)(int)> inputKinds;
+	std::vector<int> audioChannels;
+	struct Cable {
+		Module* outputModule;
+		int outputId;
+		Module* inputModule;
+		int inputId;
+	};
+	std::vector<Cable> cables;
+	uint32_t noiseState = 0x12345678;
+
+
+	StubEngine(float _sampleRate) {
+		sampleRate = _sampleRate;
+		sampleTime = 1.0f / sampleRate;
+	}
+
+	~StubEngine() {
+		for (Module* m : modules) {
+			delete m;
+		}
+	}
+
+	Module* add(Model* model, int (*inputKind)(int), int _audioChannels) {
+		Module* m = model->createModule();
+		m->id = (int64_t)(modules.size() + 1);
+		// connect inputs and outputs, as the engine would do when cables are added
+		for (int i = 0; i < (int)m->inputs.size(); i++) {
+			int kind = inputKind ? inputKind(i) : SIG_NONE;
+			m->inputs[i].channels = (kind == SIG_NONE ? 0 : (kind == SIG_AUDIO ? _audioChannels : 1));
+		}
+		for (int i = 0; i < (int)m->outputs.size(); i++) {
+			m->outputs[i].channels = 1;// module will resize as needed
+		}
+		Module::SampleRateChangeEvent e;
+		e.sampleRate = sampleRate;
+		e.sampleTime = sampleTime;
+		m->onSampleRateChange(e);
+		modules.push_back(m);
+		inputKinds.push_back(inputKind);
+		audioChannels.push_back(_audioChannels);
+		return m;
+	}
+
+	void setRightExpander(Module* left, Module* right) {
+		left->rightExpander.moduleId = right->id;
+		left->rightExpander.module = right;
+		right->leftExpander.moduleId = left->id;
+		right->leftExpander.module = left;
+	}
+
+	void addCable(Module* outputModule, int outputId, Module* inputModule, int inputId) {
+		// as Rack's engine does when a cable is added: ports get one channel and both modules are told
+		cables.push_back({outputModule, outputId, inputModule, inputId});
+		outputModule->outputs[outputId].channels = std::max<uint8_t>(outputModule->outputs[outputId].channels, 1);
+		inputModule->inputs[inputId].channels = 1;
+		Module::PortChangeEvent e;
+		e.connecting = true;
+		e.type = Port::OUTPUT;
+		e.portId = outputId;
+		outputModule->onPortChange(e);
+		e.type = Port::INPUT;
+		e.portId = inputId;
+		inputModule->onPortChange(e);
+	}
+
+	void setEco(bool eco) {
+		// only modules that save an "ecoMode" key have an eco mode (aux expanders follow their mother)
+		for (Module* m : modules) {
+			json_t* dataJ = m->dataToJson();
+			if (dataJ) {
+				if (json_object_get(dataJ, "ecoMode")) {
+					json_object_set_new(dataJ, "ecoMode", json_integer(eco ? 0xFFFF : 0));
+					m->dataFromJson(dataJ);
+				}
+				json_decref(dataJ);
+			}
+		}
+	}
+
+	void setEcoAdaptive(int budget) {
+		// budget is in percent of the sample period, see GlobalInfo::ecoBudget
+		for (Module* m : modules) {
+			json_t* dataJ = m->dataToJson();
+			if (dataJ) {
+				if (json_object_get(dataJ, "ecoAdaptive")) {
+					json_object_set_new(dataJ, "ecoAdaptive", json_integer(1));
+					json_object_set_new(dataJ, "ecoBudget", json_integer(budget));
+					m->dataFromJson(dataJ);
+				}
+				json_decref(dataJ);
+			}
+		}
+	}
+
+	float noise() {
+		// xorshift32, cheap and deterministic, in [-1.0f : 1.0f]
+		noiseState ^= noiseState << 13;
+		noiseState ^= noiseState >> 17;
+		noiseState ^= noiseState << 5;
+		return (float)(int32_t)noiseState * (1.0f / 2147483648.0f);
+	}
+
+	void fillInputs() {
+		float t = (float)frame * sampleTime;
+		float sine = std::sin(2.0f * M_PI * 220.0f * t);
+		float cv = 5.0f + 5.0f * std::sin(2.0f * M_PI * 0.5f * t);// slow sweep of 0V to 10V
+		float clk = ((frame % (int64_t)(sampleRate * 0.125f)) < 100) ? 10.0f : 0.0f;// 8 Hz clock
+		for (size_t mi = 0; mi < modules.size(); mi++) {
+			Module* m = modules[mi];
+			if (!inputKinds[mi]) {
+				continue;
+			}
+			for (int i = 0; i < (int)m->inputs.size(); i++) {
+				switch (inputKinds[mi](i)) {
+					case SIG_AUDIO :
+						for (int c = 0; c < audioChannels[mi]; c++) {
+							m->inputs[i].setVoltage(4.0f * sine + noise(), c);
+						}
+					break;
+					case SIG_CV :
+						m->inputs[i].setVoltage(cv);
+					break;
+					case SIG_GATE :
+						m->inputs[i].setVoltage(10.0f);
+					break;
+					case SIG_CLOCK :
+						m->inputs[i].setVoltage(clk);
+					break;
+				}
+			}
+		}
+	}
+
+	void step() {
+		Module::ProcessArgs args;
+		args.sampleRate = sampleRate;
+		args.sampleTime = sampleTime;
+		args.frame = frame;
+		for (Module* m : modules) {
+			m->process(args);
+		}
+		// step cables, the inputs get the outputs of this sample
+		for (Cable& cable : cables) {
+			Output& output = cable.outputModule->outputs[cable.outputId];
+			Input& input = cable.inputModule->inputs[cable.inputId];
+			int channels = output.channels;
+			for (int c = 0; c < channels; c++) {
+				input.voltages[c] = output.voltages[c];
+			}
+			for (int c = channels; c < input.channels; c++) {
+				input.voltages[c] = 0.0f;
+			}
+			input.channels = channels;
+		}
+		// flip expander messages
+		for (Module* m : modules) {
+			if (m->leftExpander.messageFlipRequested) {
+				std::swap(m->leftExpander.producerMessage, m->leftExpander.consumerMessage);
+				m->leftExpander.messageFlipRequested = false;
+			}
+			if (m->rightExpander.messageFlipRequested) {
+				std::swap(m->rightExpander.producerMessage, m->rightExpander.consumerMessage);
+				m->rightExpander.messageFlipRequested = false;
+			}
+		}
+		frame++;
+	}
+};
+
+
+static double runCase(const BenchCase& bc, bool eco, int64_t numSamples, float sampleRate) {
+	StubEngine engine(sampleRate);
+	APP->engine->setSampleRate(sampleRate);
+	Module* m = engine.add(*bc.model, bc.inputKind, bc.audioChannels);
+	for (int k = 1; k < bc.numChained; k++) {
+		// the previous mixer goes into the chain inputs of this one, the last mixer is the master of the chain
+		Module* next = engine.add(*bc.model, bc.inputKind, bc.audioChannels);
+		for (int lr = 0; lr < 2; lr++) {
+			engine.addCable(m, MM_MAIN_OUTPUTS + lr, next, MM_CHAIN_INPUTS + lr);
+		}
+		m = next;
+	}
+	if (bc.rightExpanderModel) {
+		Module* exp = engine.add(*bc.rightExpanderModel, bc.expanderInputKind, bc.audioChannels);
+		engine.setRightExpander(m, exp);
+	}
+	engine.setEco(eco);
+
+	// warm up (lets slewers, expander handshake and slow values settle), then time
+	int64_t numWarmup = (int64_t)sampleRate;
+	for (int64_t i = 0; i < numWarmup; i++) {
+		engine.fillInputs();
+		engine.step();
+	}
+	auto start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < numSamples; i++) {
+		engine.fillInputs();
+		engine.step();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	// subtract the cost of the synthetic inputs, measured alone
+	auto inputStart = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < numSamples; i++) {
+		engine.fillInputs();
+		engine.frame++;
+	}
+	auto inputEnd = std::chrono::steady_clock::now();
+	double inputTime = std::chrono::duration<double, std::nano>(inputEnd - inputStart).count();
+
+	double totalTime = std::chrono::duration<double, std::nano>(end - start).count();
+	return std::max(0.0, totalTime - inputTime) / (double)numSamples;
+}
+
+
+// Whole fades of updateFadeGain() (MixerCommon.cpp) for every fade profile, symmetrical or not, against the same fades
+// computed in double with std::expm1() and std::log1p(); fade rates are the extremes of the fade knob, eco or not.
+// The fade curves are in lookup tables, so this catches a table or an update that drifts from the exact curves.
+static double fadeCurveRef(double x, float shape) {
+	const double A = 4.0;
+	x = std::min(std::max(x, 0.0), 1.0);
+	double curve = shape > 0.0f ? std::expm1(A * x) / std::expm1(A) : std::log1p(x * std::expm1(A)) / A;
+	return x + (curve - x) * std::fabs(shape);
+}
+
+static double checkFade(float shape, bool symmetricalFade, float timeStepX, bool up, bool simd4) {
+	float target = up ? 1.0f : 0.0f;
+	float gain = 1.0f - target;
+	float gainX = gain;
+	float gainXr = 0.0f;
+	simd::float_4 gain4 = gain;
+	simd::float_4 gainX4 = gainX;
+	simd::float_4 gainXr4 = gainXr;
+	double gainRef = gain;
+	double maxErr = 0.0;
+	
+	for (int i = 0; gainX != target || gain != target; i++) {
+		float gainXrPrev = gainXr;
+		if (i > 2.0f / timeStepX) {
+			return 1.0;// fade does not end
+		}
+		if (simd4) {
+			gain4 = updateFadeGain(gain4, simd::float_4(target), &gainX4, &gainXr4, simd::float_4(timeStepX), simd::float_4(shape), symmetricalFade);
+			for (int l = 1; l < 4; l++) {
+				if (gain4[l] != gain4[0]) {
+					return 1.0;// lanes differ
+				}
+			}
+			gain = gain4[0];
+			gainX = gainX4[0];
+			gainXr = gainXr4[0];
+		}
+		else {
+			gain = updateFadeGain(gain, target, &gainX, &gainXr, timeStepX, shape, symmetricalFade);
+		}
+		if (symmetricalFade) {
+			gainRef = fadeCurveRef(gainX, shape);
+		}
+		else {
+			double step = fadeCurveRef(gainXr, shape) - fadeCurveRef(gainXrPrev, shape);
+			gainRef = up ? std::min(gainRef + step, 1.0) : std::max(gainRef - step, 0.0);
+		}
+		maxErr = std::max(maxErr, std::fabs(gain - gainRef));
+	}
+	return maxErr;
+}
+
+// returns false when a fade is further than maxErrAllowed from the reference at any sample
+static bool checkFadeGain(float sampleRate) {
+	const double maxErrAllowed = 1e-6;
+	bool ok = true;
+	std::printf("fade profile\tsymmetrical\tmax error\n");
+	for (int s = -4; s <= 4; s++) {
+		float shape = (float)s / 4.0f;// fadeProfile
+		for (int sym = 0; sym < 2; sym++) {
+			double maxErr = 0.0;
+			for (float fadeRate : {0.1f, 30.0f}) {
+				for (float eco : {1.0f, 16.0f}) {
+					float timeStepX = eco / (sampleRate * fadeRate);
+					for (int up = 0; up < 2; up++) {
+						for (int simd4 = 0; simd4 < 2; simd4++) {
+							maxErr = std::max(maxErr, checkFade(shape, sym != 0, timeStepX, up != 0, simd4 != 0));
+						}
+					}
+				}
+			}
+			bool pass = maxErr <= maxErrAllowed;
+			ok &= pass;
+			std::printf("%+.2f\t%s\t%.2g%s\n", shape, sym != 0 ? "yes" : "no", maxErr, pass ? "" : "\tFAIL");
+		}
+	}
+	return ok;
+}
+
+
+// Control-rate dividers picked by the adaptive eco of a MixMaster with an AuxSpander, as published to the expander.
+// After a warm up of a few seconds, the divider is sampled at every light refresh (256 samples): the most frequent one is 
+// where it settled, and the largest one includes the steps that the adaptive eco tries and undoes.
+static bool checkAdaptiveEco(float sampleRate) {
+	const int budget = 2;// default of GlobalInfo::ecoBudget
+	bool ok = true;
+	std::printf("adaptive eco	settled	largest	ns/sample
+");
+	for (int busy = 0; busy < 2; busy++) {
+		StubEngine engine(sampleRate);
+		APP->engine->setSampleRate(sampleRate);
+		Module* m = engine.add(modelMixMaster, busy ? kindMixMaster : NULL, 1);
+		Module* exp = engine.add(modelAuxExpander, busy ? kindAuxExpander : NULL, 1);
+		engine.setRightExpander(m, exp);
+		engine.setEcoAdaptive(budget);
+		TAfmExpInterface<16, 4>* toExpander = static_cast<TAfmExpInterface<16, 4>*>(exp->leftExpander.producerMessage);
+
+		int64_t numWarmup = (int64_t)(sampleRate * 4.0f);
+		int64_t numSamples = (int64_t)(sampleRate * 8.0f);
+		for (int64_t i = 0; i < numWarmup; i++) {
+			engine.fillInputs();
+			engine.step();
+		}
+		int64_t counts[5] = {};
+		int largest = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < numSamples; i++) {
+			engine.fillInputs();
+			engine.step();
+			if ((i & 0xFF) == 0) {
+				int level = 0;
+				for (uint16_t mask = toExpander->slowPublished.ecoMode; mask != 0 && level < 4; mask >>= 1) {
+					level++;
+				}
+				counts[level]++;
+				largest = std::max(largest, level);
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+		int settled = (int)(std::max_element(counts, counts + 5) - counts);
+		double nsPerSample = std::chrono::duration<double, std::nano>(end - start).count() / (double)numSamples;
+		bool pass = busy || (1 << largest) < 16;
+		ok &= pass;
+		std::printf("%s	1/%i	1/%i	%.2f%s\n", busy ? "busy" : "idle", 1 << settled, 1 << largest, nsPerSample, pass ? "" : "\tFAIL");
+	}
+	return ok;
+}
+
+
+int main(int argc, char* argv[]) {
+	int64_t numSamples = (argc > 1 ? std::atoll(argv[1]) : 4800000);
+	float sampleRate = (argc > 2 ? (float)std::atof(argv[2]) : 48000.0f);
+
+	// minimal headless context: an engine for the sample rate getters and a history for the modules that push undo actions
+	pluginInstance = new Plugin;
+	pluginInstance->path = ".";
+	contextSet(new Context);
+	APP->engine = new engine::Engine;
+	APP->history = new history::State;
+
+	bool fadeOk = checkFadeGain(sampleRate);
+	std::printf("\n");
+	bool ecoOk = checkAdaptiveEco(sampleRate);
+	std::printf("\n");
+
+	std::printf("module\teco\tns/sample\n");
+	for (const BenchCase& bc : benchCases) {
+		for (int eco = 0; eco < 2; eco++) {
+			double nsPerSample = runCase(bc, eco != 0, numSamples, sampleRate);
+			std::printf("%s\t%s\t%.2f\n", bc.name, eco ? "on" : "off", nsPerSample);
+			std::fflush(stdout);
+		}
+	}
+	return (fadeOk && ecoOk) ? 0 : 1;
+}
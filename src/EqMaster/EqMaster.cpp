@@ -7,7 +7,9 @@
 
 
 #include "EqWidgets.hpp"
-#include <thread>
+
+
+SpectrumService spectrumService;
 
 
 struct EqMaster : Module {
@@ -44,39 +46,28 @@ struct EqMaster : Module {
 	char trackLabels[24 * 4 + 1];// needs to be saved in case we are detached
 	int8_t trackLabelColors[24];
 	int8_t trackVuColors[24];
+	QuattroTrackBiQuad trackEqBanks[6];// eqs of the 24 tracks, four tracks per bank (in SIMD lanes), used by trackEqs
 	std::vector<TrackEq> trackEqs;// size 24
 	PackedBytes4 miscSettings;// cc4[0] is ShowBandCurvesEQ, cc4[1] is fft type (0 = off, 1 = pre, 2 = post, 3 = freeze), cc4[2] is momentaryCvButtons (1 = yes (original rising edge only version), 0 = level sensitive (emulated with rising and falling detection)), cc4[3] is detailsShow
-	PackedBytes4 miscSettings2;// cc4[0] is band label colours, cc4[1] is decay rate (0 = slow, 1 = med, 2 = fast), cc[2] is hide eq curves when bypassed, cc[3] is unused
+	PackedBytes4 miscSettings2;// cc4[0] is band label colours, cc4[1] is decay rate (0 = slow, 1 = med, 2 = fast), cc[2] is hide eq curves when bypassed, cc[3] is coefficient ramp length in samples for modulated eqs (0 = off, see QuattroTrackBiQuad)
 	PackedBytes4 showFreqAsNotes;
+	int32_t spectrumOverlay;// one bit per track whose spectrum is drawn over the selected track's one (the selected track's bit is ignored)
 	
 	
 	// No need to save, with reset
 	int updateTrackLabelRequest;// 0 when nothing to do, 1 for read names in widget, 2 for same as 1 but force param refreshing
 	VuMeterAllDual trackVu;
-	int fftWriteHead;
-	int page;
 	uint32_t cvConnected;
-	int drawBufSize;
 
 	// No need to save, no reset
 	RefreshCounter refresh;
-	PFFFT_Setup* ffts;// https://bitbucket.org/jpommier/pffft/src/default/test_pffft.c
-	float* fftIn[3];
-	float* fftOut;
+	SpectrumAnalyzer* spectrum;// selected track, see SpectrumService.hpp
+	SpectrumAnalyzer* overlaySpectrums[24] = {};// nullptr until the track is first overlaid, then kept until the module is removed
 	TriggerRiseFall trackEnableCvTriggers[24+1];
 	TriggerRiseFall trackBandCvTriggers[24][4];
 	bool expPresentLeft = false;
 	bool expPresentRight = false;
-	std::mutex m;
-	float *drawBuf;//[FFT_N] store log magnitude only in first half, log freq in second half (normally this is compacted freq bins, so not all array used)
-	float *drawBufLin;//[FFT_N_2] store lin magnitude, used for calculating decay (normally this is compacted freq bins, so not all array used)
-	float *windowFunc;//[FFT_N_2] precomputed window function for FFT; function is symetrical, so only first half of window is actually stored here
-	bool requestStop = false;
-	bool requestWork = false;
-	int requestPage = 0;
 	int32_t lastTrackMove = 0;
-	std::condition_variable cv;// https://thispointer.com//c11-multithreading-part-7-condition-variables-explained/
-	std::thread worker;// http://www.cplusplus.com/reference/thread/thread/thread/
 	
 	int getSelectedTrack() {
 		return (int)(params[TRACK_PARAM].getValue() + 0.5f);
@@ -98,19 +89,19 @@ struct EqMaster : Module {
 		}
 	}
 	
-	float *allocateAndCalcWindowFunc() {
-		float *buf = static_cast<float*>(pffft_aligned_malloc(FFT_N_2 * 4));
-		for (unsigned int i = 0; i < (FFT_N_2 / 4); i++) {
-			simd::float_4 p = {(float)(i * 4 + 0), (float)(i * 4 + 1), (float)(i * 4 + 2), (float)(i * 4 + 3)};
-			p /= (float)(FFT_N - 1);
-			p = dsp::blackmanHarris<simd::float_4>(p);
-			p.store(&(buf[i * 4]));		
-		}	
-		return buf;
+	void setSpectrumOverlay(int32_t _spectrumOverlay) {// not on the engine thread, since analyzers are allocated here
+		for (int t = 0; t < 24; t++) {
+			if ((_spectrumOverlay & (1 << t)) != 0 && overlaySpectrums[t] == nullptr) {
+				overlaySpectrums[t] = spectrumService.subscribe(FFT_N);
+				overlaySpectrums[t]->sampleRate = spectrum->sampleRate;
+				overlaySpectrums[t]->decayFactor = spectrum->decayFactor;
+			}
+		}
+		spectrumOverlay = _spectrumOverlay;// after the analyzers exist, since the engine thread uses the ones in spectrumOverlay
 	}
 	
 		
-	EqMaster() : worker(&EqMaster::worker_thread, this) {
+	EqMaster() {
 		config(NUM_EQ_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
 		
 		rightExpander.producerMessage = &expMessages[0];
@@ -153,40 +144,22 @@ struct EqMaster : Module {
 		trackEqs.reserve(24);
 		float sr = APP->engine->getSampleRate();
 		for (int t = 0; t < 24; t++) {
-			trackEqs.push_back(TrackEq(t, sr, &cvConnected));
+			trackEqs.push_back(TrackEq(t, sr, &cvConnected, &trackEqBanks[t >> 2]));
 		}
 		
-		ffts = pffft_new_setup(FFT_N, PFFFT_REAL);
-		fftIn[0] = static_cast<float*>(pffft_aligned_malloc(FFT_N * 4));
-		fftIn[1] = static_cast<float*>(pffft_aligned_malloc(FFT_N * 4));
-		fftIn[2] = static_cast<float*>(pffft_aligned_malloc(FFT_N * 4));
-		fftOut = static_cast<float*>(pffft_aligned_malloc(FFT_N * 4));
-		drawBuf = static_cast<float*>(pffft_aligned_malloc(FFT_N * 4));
-		drawBufLin = static_cast<float*>(pffft_aligned_malloc(FFT_N_2 * 4));
-		for (int i = 0; i < FFT_N_2; i++) {
-			drawBuf[i] = -1.0f;
-			drawBufLin[i] = 0.0f;
-		}
-		windowFunc = allocateAndCalcWindowFunc();
+		spectrum = spectrumService.subscribe(FFT_N);
+		spectrum->sampleRate = sr;
 		
 		onReset();
 	}
   
 	~EqMaster() {
-		std::unique_lock<std::mutex> lk(m);
-		requestStop = true;
-		lk.unlock();
-		cv.notify_one();
-		worker.join();
-		
-		pffft_destroy_setup(ffts);
-		pffft_aligned_free(fftIn[0]);
-		pffft_aligned_free(fftIn[1]);
-		pffft_aligned_free(fftIn[2]);
-		pffft_aligned_free(fftOut);
-		pffft_aligned_free(drawBuf);
-		pffft_aligned_free(drawBufLin);
-		pffft_aligned_free(windowFunc);
+		spectrumService.unsubscribe(spectrum);
+		for (int t = 0; t < 24; t++) {
+			if (overlaySpectrums[t] != nullptr) {
+				spectrumService.unsubscribe(overlaySpectrums[t]);
+			}
+		}
 	}
   
 	void onReset() override final {
@@ -202,17 +175,21 @@ struct EqMaster : Module {
 		miscSettings2.cc4[0] = 0;// band label colors
 		miscSettings2.cc4[1] = 2;// decay rate fast
 		miscSettings2.cc4[2] = 0;// hide eq curves when bypassed
-		miscSettings2.cc4[3] = 0;// unused
+		miscSettings2.cc4[3] = 0;// coefficient ramps off
 		showFreqAsNotes.cc1 = 0;
+		spectrumOverlay = 0;
 		resetNonJson();
 	}
 	void resetNonJson() {
 		updateTrackLabelRequest = 1;
 		trackVu.reset();
-		fftWriteHead = 0;
-		page = 0;
 		cvConnected = 0;
-		drawBufSize = -1;// no data to draw yet
+		spectrum->reset();// no data to draw yet
+		for (int t = 0; t < 24; t++) {
+			if (overlaySpectrums[t] != nullptr) {
+				overlaySpectrums[t]->reset();
+			}
+		}
 	}
 
 
@@ -252,6 +229,9 @@ struct EqMaster : Module {
 		// showFreqAsNotes
 		json_object_set_new(rootJ, "showFreqAsNotes", json_integer(showFreqAsNotes.cc1));
 				
+		// spectrumOverlay
+		json_object_set_new(rootJ, "spectrumOverlay", json_integer(spectrumOverlay));
+				
 		// trackEqs
 		// -------------
 		
@@ -398,6 +378,11 @@ struct EqMaster : Module {
 		if (showFreqAsNotesJ)
 			showFreqAsNotes.cc1 = json_integer_value(showFreqAsNotesJ);
 
+		// spectrumOverlay
+		json_t *spectrumOverlayJ = json_object_get(rootJ, "spectrumOverlay");
+		if (spectrumOverlayJ)
+			setSpectrumOverlay(json_integer_value(spectrumOverlayJ));
+
 		// trackEqs
 		// -------------
 
@@ -539,92 +524,33 @@ struct EqMaster : Module {
 	
 	
 	
-	void worker_thread() {
-		static const float vertScaling = 1.1f;
-		static const float vertOffset = 10.0f;
-		while (true) {
-			std::unique_lock<std::mutex> lk(m);
-			while (!requestWork && !requestStop) {
-				cv.wait(lk);
-			}
-			lk.unlock();
-			if (requestStop) break;
-			
-			// compute fft
-			pffft_transform_ordered(ffts, fftIn[requestPage], fftOut, NULL, PFFFT_FORWARD);
-
-			// calculate magnitude and store in 1st half of array
-			for (int x = 0; x < FFT_N ; x += 2) {	
-				fftOut[x >> 1] = fftOut[x + 0] * fftOut[x + 0] + fftOut[x + 1] * fftOut[x + 1];// sqrt is not needed in magnitude calc since when take log of this, it can be absorbed in scaling multiplier
-			}
-			
-			// calculate pixel scaled log of frequency and store in 2nd half of array
-			for (int x = 0; x < (FFT_N_2) / 4 ; x++) {
-				int xt4 = x << 2;
-				simd::float_4 vecp(xt4 + 0, xt4 + 1, xt4 + 2, xt4 + 3);
-				vecp = (vecp / ((float)(FFT_N - 1))) * trackEqs[0].getSampleRate();// linear freq a this line
-				vecp = simd::round(simd::rescale(simd::log10(vecp), minLogFreq, maxLogFreq, 0.0f, eqCurveWidth));// pixel scaled log freq at this line
-				vecp.store(&fftOut[xt4 + FFT_N_2]);
-			}
-			
-			// compact frequency bins
-			int i = 1;// index into compacted bins 
-			drawBuf[FFT_N_2] = fftOut[FFT_N_2];
-			for (int x = 1; x < FFT_N_2 ; x++) {// index into non-compacted bins
-				if (drawBuf[i - 1 + FFT_N_2] == fftOut[x + FFT_N_2]) {
-					fftOut[i - 1] = std::fmax(fftOut[i - 1], fftOut[x]);
-				}
-				else {
-					fftOut[i] = fftOut[x];
-					drawBuf[i + FFT_N_2] = fftOut[x + FFT_N_2];
-					i++;
-				}
-			}
-			int compactedSize = i;
-			
-			// decay
-			static constexpr float noDecay = 1000.0f;
-			float decayFactor = 0.0f;
-			if ((miscSettings.cc4[1] & SPEC_MASK_FREEZE) == 0) {
-				if (miscSettings2.cc4[1] == 0) {// slow decay
-					decayFactor = 5.0f;
-				} 
-				else if (miscSettings2.cc4[1] == 1) {// med decay
-					decayFactor = 12.0f;
-				}
-				else if (miscSettings2.cc4[1] == 2) {// fast decay
-					decayFactor = 20.0f;
-				}
-				else {
-					decayFactor = noDecay;
-				}
+	float getSpectrumSample(int i, int t) {// input i, track t of that input (0 to 7)
+		return ((miscSettings.cc4[1] & SPEC_MASK_POST) == 0 ? 
+					(inputs[SIG_INPUTS + i].getVoltage((t << 1) + 0) + inputs[SIG_INPUTS + i].getVoltage((t << 1) + 1)) : 
+					(outputs[SIG_OUTPUTS + i].getVoltage((t << 1) + 0) + outputs[SIG_OUTPUTS + i].getVoltage((t << 1) + 1)));// no need to div by two, scaling done later
+	}
+	
+	
+	void setSpectrumSettings(SpectrumAnalyzer* analyzer, float sampleRate) {
+		float decayFactor = 0.0f;
+		if ((miscSettings.cc4[1] & SPEC_MASK_FREEZE) == 0) {
+			if (miscSettings2.cc4[1] == 0) {// slow decay
+				decayFactor = 5.0f;
+			} 
+			else if (miscSettings2.cc4[1] == 1) {// med decay
+				decayFactor = 12.0f;
 			}
-			if (decayFactor != noDecay) {
-				for (i = 0; i < compactedSize; i++) {
-					if (fftOut[i] > drawBufLin[i]) {
-						drawBufLin[i] = fftOut[i];
-					}
-					else {
-						drawBufLin[i] += (fftOut[i] - drawBufLin[i]) * decayFactor * FFT_N_2 / trackEqs[0].getSampleRate();// decay
-					}
-				}
+			else if (miscSettings2.cc4[1] == 2) {// fast decay
+				decayFactor = 20.0f;
 			}
 			else {
-				memcpy(&drawBufLin[0], &fftOut[0], compactedSize * 4);
-			}
-			
-			// calculate log of magnitude and transfer to drawBuf
-			for (int x = 0; x < ((compactedSize + 3) >> 2) ; x++) {
-				simd::float_4 vecp = simd::float_4::load(&drawBufLin[x << 2]);
-				vecp = simd::fmax(vertScaling * 20.0f * simd::log10(vecp) + vertOffset, -1.0f);// fmax for proper enclosed region for fill
-				vecp.store(&drawBuf[x << 2]);					
+				decayFactor = SpectrumService::noDecay;
 			}
-		
-			drawBufSize = compactedSize;
-
-			requestWork = false;
 		}
-	}	
+		analyzer->sampleRate = sampleRate;
+		analyzer->decayFactor = decayFactor;
+	}
+	
 
 	void process(const ProcessArgs &args) override {
 		int selectedTrack = getSelectedTrack();
@@ -665,63 +591,53 @@ struct EqMaster : Module {
 			outputs[SIG_OUTPUTS + 0].setChannels(numChannels16);
 			outputs[SIG_OUTPUTS + 1].setChannels(numChannels16);
 			outputs[SIG_OUTPUTS + 2].setChannels(numChannels16);
+			for (int i = 0; i < 6; i++) {
+				trackEqBanks[i].setRampLength(miscSettings2.cc4[3]);
+			}
+			setSpectrumSettings(spectrum, args.sampleRate);
+			for (int t = 0; t < 24; t++) {
+				if ((spectrumOverlay & (1 << t)) != 0) {
+					setSpectrumSettings(overlaySpectrums[t], args.sampleRate);
+				}
+			}
 		}// userInputs refresh
 		
 		
 		//********** Outputs **********
 
 		bool vuProcessed = false;
+		bool globalEnable = params[GLOBAL_BYPASS_PARAM].getValue() < 0.5f;
 		for (int i = 0; i < 3; i++) {
 			if (inputs[SIG_INPUTS + i].isConnected()) {
-				for (int t = 0; t < 8; t++) {
-					const float* in = inputs[SIG_INPUTS + i].getVoltages((t << 1) + 0);
-					float out[2];
-					bool globalEnable = params[GLOBAL_BYPASS_PARAM].getValue() < 0.5f;
-					trackEqs[(i << 3) + t].process(out, in, globalEnable);
-					outputs[SIG_OUTPUTS + i].setVoltage(out[0], (t << 1) + 0);
-					outputs[SIG_OUTPUTS + i].setVoltage(out[1], (t << 1) + 1);
-					if ( ((i << 3) + t) == selectedTrack ) {
-						// VU
-						trackVu.process(args.sampleTime, out);
-						vuProcessed = true;
-						
-						// Spectrum
-						if ( (miscSettings.cc4[1] & SPEC_MASK_ON) != 0 ) {
-							float sample = ((miscSettings.cc4[1] & SPEC_MASK_POST) == 0 ? 
-												(in[0] + in[1]) : 
-												(out[0] + out[1]));// no need to div by two, scaling done later
-							
-							// write sample into fft input buffers and apply windowing
-							fftIn[page][fftWriteHead] = sample * windowFunc[fftWriteHead >= FFT_N_2 ? ((FFT_N - 1) - fftWriteHead) : fftWriteHead];// * dsp::blackmanHarris((float)fftWriteHead / (float)(FFT_N - 1));
-							if (fftWriteHead >= FFT_N_2) {
-								int offsetHead = fftWriteHead - FFT_N_2;
-								fftIn[(page + 1) % 3][offsetHead] = sample * windowFunc[offsetHead];// * dsp::blackmanHarris((float)offsetHead / (float)(FFT_N - 1));
-							}	
-							
-							// increment write head and possibly page
-							fftWriteHead++;
-							if (fftWriteHead >= FFT_N) {
-								fftWriteHead = FFT_N_2;
-								//thread 
-								if (requestWork) {
-									// INFO("FFT too slow, page skipped");
-								}
-								else {
-									requestPage = page;
-									requestWork = true;
-									cv.notify_one();
-								}
-								page++;
-								if (page >= 3) {
-									page = 0;
-								}
-							}
-						}
-						else {
-							fftWriteHead = 0;
-							page = 0;
-						}// Spectrum
+				// eqs, four tracks at a time (8 channels, interleaved as L R L R ... in the cables)
+				for (int g = 0; g < 2; g++) {
+					int trk0 = (i << 3) + (g << 2);
+					for (int t = 0; t < 4; t++) {
+						trackEqs[trk0 + t].process(globalEnable);
 					}
+					simd::float_4 in0 = inputs[SIG_INPUTS + i].getVoltageSimd<simd::float_4>((g << 3) + 0);
+					simd::float_4 in1 = inputs[SIG_INPUTS + i].getVoltageSimd<simd::float_4>((g << 3) + 4);
+					simd::float_4 outL;
+					simd::float_4 outR;
+					trackEqBanks[trk0 >> 2].process(&outL, &outR, _mm_shuffle_ps(in0.v, in1.v, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(in0.v, in1.v, _MM_SHUFFLE(3, 1, 3, 1)));
+					outputs[SIG_OUTPUTS + i].setVoltageSimd(simd::float_4(_mm_unpacklo_ps(outL.v, outR.v)), (g << 3) + 0);
+					outputs[SIG_OUTPUTS + i].setVoltageSimd(simd::float_4(_mm_unpackhi_ps(outL.v, outR.v)), (g << 3) + 4);
+				}
+				
+				if ((selectedTrack >> 3) == i) {
+					int t = selectedTrack & 0x7;
+					const float* out = outputs[SIG_OUTPUTS + i].getVoltages((t << 1) + 0);
+					// VU
+					trackVu.process(args.sampleTime, out);
+					vuProcessed = true;
+					
+					// Spectrum
+					if ( (miscSettings.cc4[1] & SPEC_MASK_ON) != 0 ) {
+						spectrumService.write(spectrum, getSpectrumSample(i, t));
+					}
+					else {
+						spectrum->restart();
+					}// Spectrum
 				}
 			}
 		}
@@ -729,7 +645,23 @@ struct EqMaster : Module {
 			trackVu.reset();
 		}
 		if (!vuProcessed || (miscSettings.cc4[1] & SPEC_MASK_ON) == 0) {
-			drawBufSize = -1;
+			spectrum->drawBufSize = -1;
+		}
+		
+		// Spectrum overlays, same as the selected track's spectrum but without its VU
+		if (spectrumOverlay != 0) {
+			bool specOn = (miscSettings.cc4[1] & SPEC_MASK_ON) != 0;
+			for (int t = 0; t < 24; t++) {
+				if ((spectrumOverlay & (1 << t)) == 0) continue;
+				SpectrumAnalyzer* overlaySpectrum = overlaySpectrums[t];
+				if (specOn && t != selectedTrack && inputs[SIG_INPUTS + (t >> 3)].isConnected()) {
+					spectrumService.write(overlaySpectrum, getSpectrumSample(t >> 3, t & 0x7));
+				}
+				else {
+					overlaySpectrum->restart();
+					overlaySpectrum->drawBufSize = -1;
+				}
+			}
 		}
 		
 		//********** Lights **********
@@ -862,10 +794,35 @@ struct EqMasterWidget : ModuleWidget {
 		decayItem->decayRateSrc = &(module->miscSettings2.cc4[1]);
 		menu->addChild(decayItem);
 		
+		menu->addChild(createSubmenuItem("Analyser overlays", "", [=](Menu* menu) {
+			// spectrums of other tracks drawn over the selected track's one, to spot masking
+			menu->addChild(createMenuItem("None", "",
+				[=]() {module->setSpectrumOverlay(0);}
+			));
+			for (int t = 0; t < 24; t++) {
+				menu->addChild(createCheckMenuItem(std::string(&(module->trackLabels[t * 4]), 4), "",
+					[=]() {return (module->spectrumOverlay & (1 << t)) != 0;},
+					[=]() {module->setSpectrumOverlay(module->spectrumOverlay ^ (1 << t));}
+				));
+			}
+		}));
+		
 		menu->addChild(createCheckMenuItem("Hide EQ curves when bypassed", "",
 			[=]() {return module->miscSettings2.cc4[2] != 0;},
 			[=]() {module->miscSettings2.cc4[2] ^= 0x1;}
 		));	
+		
+		menu->addChild(createSubmenuItem("Modulated EQ coefficients", module->miscSettings2.cc4[3] == 0 ? "Per sample" : string::f("Ramped, %i", module->miscSettings2.cc4[3]), [=](Menu* menu) {
+			// while band freqs and gains slew (knobs or CVs), exact coefficients are computed every rampLength samples only
+			static const int8_t rampLengths[3] = {0, 16, 32};
+			for (int i = 0; i < 3; i++) {
+				int8_t rampLength = rampLengths[i];
+				menu->addChild(createCheckMenuItem(rampLength == 0 ? "Per sample" : string::f("Ramped every %i samples", rampLength), "",
+					[=]() {return module->miscSettings2.cc4[3] == rampLength;},
+					[=]() {module->miscSettings2.cc4[3] = rampLength;}
+				));
+			}
+		}));
 
 		menu->addChild(new MenuSeparator());
 		
@@ -955,8 +912,10 @@ struct EqMasterWidget : ModuleWidget {
 			eqCurveAndGrid->globalBypassParamSrc = &(module->params[GLOBAL_BYPASS_PARAM]);
 			eqCurveAndGrid->bandParamsWithCvs = bandParamsWithCvs;
 			eqCurveAndGrid->bandParamsCvConnected = &bandParamsCvConnected;
-			eqCurveAndGrid->drawBuf = module->drawBuf;
-			eqCurveAndGrid->drawBufSize = &(module->drawBufSize);
+			eqCurveAndGrid->drawBuf = module->spectrum->drawBuf;
+			eqCurveAndGrid->drawBufSize = &(module->spectrum->drawBufSize);
+			eqCurveAndGrid->overlaySpectrumsSrc = module->overlaySpectrums;
+			eqCurveAndGrid->spectrumOverlaySrc = &(module->spectrumOverlay);
 			eqCurveAndGrid->lastMovedKnobIdSrc = &lastMovedKnobId;
 			eqCurveAndGrid->lastMovedKnobTimeSrc = &lastMovedKnobTime;
 		}
@@ -102,7 +102,8 @@ class TrackEq {
 	simd::float_4 qCv;// adding-type cvs
 
 	// dependents
-	QuattroBiQuad eqs;
+	QuattroTrackBiQuad* eqs;// shared with the three other tracks of the same group of four, this track is lane trackNum % 4
+	int eqsLane;
 	TSlewLimiterSingle<simd::float_4> freqSlewers;// in log(Hz)
 	TSlewLimiterSingle<simd::float_4> gainSlewers;// in dB
 	SlewLimiterSingle trackGainSlewer;// in dB
@@ -110,10 +111,12 @@ class TrackEq {
 	
 	public:
 	
-	TrackEq(int _trackNum, float _sampleRate, uint32_t *_cvConnected) {
+	TrackEq(int _trackNum, float _sampleRate, uint32_t *_cvConnected, QuattroTrackBiQuad* _eqs) {
 		trackNum = _trackNum;
 		updateSampleRate(_sampleRate);// sampleRate, sampleTime
 		cvConnected = _cvConnected;
+		eqs = _eqs;
+		eqsLane = _trackNum & 0x3;
 		
 		dirty = 0xF;
 		bandTypes[1] = QuattroBiQuad::PEAK;
@@ -156,7 +159,7 @@ class TrackEq {
 		qCv = 0.0f;
 		
 		// dependents
-		eqs.reset();
+		eqs->reset(eqsLane);// also sets the lane's out gain to 1.0f, to match trackGainSlewer
 		freqSlewers.reset();
 		gainSlewers.reset();
 		trackGainSlewer.reset();
@@ -289,7 +292,8 @@ class TrackEq {
 		if (trackGain != DEFAULT_trackGain) return true;
 		return false;
 	}
-	void process(float* out, const float* in, bool globalEnable) {
+	// slews the band parameters and the track gain, and updates this track's lane of eqs when they changed, must be called before eqs->process()
+	void process(bool globalEnable) {
 		bool _cvConnected = getCvConnected();
 		
 		// freq slewers with freq cvs
@@ -316,30 +320,33 @@ class TrackEq {
 		}
 		
 		// update eq parameters according to dirty flags
-		if (dirty != 0) {
+		// while the slewers move and coefficient ramps are on, the parameters are only updated at the ramps' boundaries 
+		// (dirty bits are kept until then), and the eqs ramp to them
+		bool ramped = (eqs->getRampLength() != 0 && (freqSlewersComparisonMask != 0xF || gainSlewersComparisonMask != 0xF));
+		if (dirty != 0 && (!ramped || eqs->isRampBoundary())) {
 			simd::float_4 normalizedFreq = simd::fmin(0.5f, simd::pow(10.0f, freqSlewers.out) / sampleRate);
 			simd::float_4 linearGain = simd::pow(10.0f, gainSlewers.out / 20.0f);
 			simd::float_4 qWithCv = getQWithCvVec(_cvConnected);
+			QuattroBiQuadCoeff coeffs;// all four bands in one vector pass, even when only some are dirty
+			coeffs.setParametersVec(bandTypes, normalizedFreq, linearGain, qWithCv);
 			for (int b = 0; b < 4; b++) {
 				if ((dirty & (1 << b)) != 0) {
-					eqs.setParameters(b, bandTypes[b], normalizedFreq[b], linearGain[b], qWithCv[b]);
+					if (ramped) {
+						eqs->setCoefficientsRamped(eqsLane, b, coeffs, b, linearGain[b]);
+					}
+					else {
+						eqs->setCoefficients(eqsLane, b, coeffs, b, linearGain[b]);
+					}
 				}
 			}
+			dirty = 0x0;
 		}
-		dirty = 0x0;		
 				
-		// perform equalization		
-		eqs.process(out, in);
-		
-		// apply track gain (with slewer)
+		// track gain (with slewer), the linear gain is kept in eqs and only recalculated while the slewer moves
 		float finalTrackGain = ((trackActive && globalEnable) ? trackGain : 0.0f);
 		if (finalTrackGain != trackGainSlewer.out) {
 			trackGainSlewer.process(sampleTime, finalTrackGain);
-		}
-		if (trackGainSlewer.out != 0.0f) {
-			float linearTrackGain = std::pow(10.0f, trackGainSlewer.out / 20.0f);
-			out[0] *= linearTrackGain;
-			out[1] *= linearTrackGain;
+			eqs->setOutGain(eqsLane, trackGainSlewer.out == 0.0f ? 1.0f : dbToLinearFast(trackGainSlewer.out));
 		}
 	}
 };
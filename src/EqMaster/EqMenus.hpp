@@ -107,12 +107,20 @@ struct MixerLinkItem : MenuItem {
 
 		bool sawMappedId = *mappedIdSrc == 0;
 		
-		std::vector<MessageBase>* mixerMessageSurvey = mixerMessageBus.surveyValues();
-		for (MessageBase pl : *mixerMessageSurvey) {
+		MessageBase mixerMessageSurvey[MixerMessageBus::MAX_MEMBERS];
+		int numMixers = mixerMessageBus.surveyValues(mixerMessageSurvey);
+		for (int i = 0; i < numMixers; i++) {
+			MessageBase pl = mixerMessageSurvey[i];
 			if (*mappedIdSrc == pl.id) {
 				sawMappedId = true;
 			}
-			std::string mixerName = std::string(pl.name) + string::f("  (id %" PRId64 ")", pl.id);
+			std::string mixerName = std::string(pl.name);
+			int64_t shownId = pl.id;
+			if (pl.numTrackPages > 1) {// mixer with more than 16 tracks, one item per 16 tracks
+				mixerName += string::f(" %i-%i", pl.trackPage * 16 + 1, pl.trackPage * 16 + 16);
+				shownId = (pl.trackPage == 0 ? pl.id : (-pl.id) >> 2);
+			}
+			mixerName += string::f("  (id %" PRId64 ")", shownId);
 			menu->addChild(createCheckMenuItem(mixerName, "",
 				[=]() {return *mappedIdSrc == pl.id;},
 				[=]() {
@@ -126,7 +134,6 @@ struct MixerLinkItem : MenuItem {
 				}
 			));	
 		}
-		delete mixerMessageSurvey;
 		
 		if (!sawMappedId) {
 			int64_t deletedMappedIdSrc = *mappedIdSrc;
@@ -164,7 +171,8 @@ struct CopyTrackSettingsItem : MenuItem {
 
 void moveTrack(TrackEq *trackEqsSrc, int trackNumSrc, int trackNumDest) {
 	// does not check for trackNumSrc == trackNumDest
-	TrackEq buffer1(0, 0.0f, nullptr);
+	QuattroTrackBiQuad buffer1Eqs;
+	TrackEq buffer1(0, 0.0f, nullptr, &buffer1Eqs);
 	
 	buffer1.copyFrom(&trackEqsSrc[trackNumSrc]);
 	if (trackNumDest < trackNumSrc) {
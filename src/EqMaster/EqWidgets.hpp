@@ -9,8 +9,7 @@
 #pragma once
 
 #include "EqMenus.hpp"
-#include "dsp/fft.hpp"
-#include <condition_variable>
+#include "SpectrumService.hpp"
 
 
 // Labels
@@ -541,6 +540,8 @@ struct EqCurveAndGrid : TransparentWidget {
 	bool *bandParamsCvConnected = nullptr;
 	float *drawBuf = nullptr;// store log magnitude only in first half, log freq in second half
 	int *drawBufSize = nullptr;
+	SpectrumAnalyzer** overlaySpectrumsSrc = nullptr;// [24]
+	int32_t* spectrumOverlaySrc = nullptr;
 	int* lastMovedKnobIdSrc = nullptr;
 	time_t* lastMovedKnobTimeSrc = nullptr;
 	
@@ -579,6 +580,9 @@ struct EqCurveAndGrid : TransparentWidget {
 				if (*drawBufSize > 0) {
 					drawSpectrum(args);
 				}
+				if (*spectrumOverlaySrc != 0) {
+					drawSpectrumOverlays(args);
+				}
 
 				bool hideEqCurves = miscSettings2Src->cc4[2] != 0 && (!trackEqsSrc[currTrk].getTrackActive() || globalBypassParamSrc->getValue() >= 0.5f);
 
@@ -719,6 +723,32 @@ struct EqCurveAndGrid : TransparentWidget {
 		nvgStroke(args.vg);
 	}
 
+	void drawSpectrumOverlays(const DrawArgs &args) {
+		// outlines only, with the display colours other than the first two (yellow and light gray) in turn
+		nvgLineCap(args.vg, NVG_ROUND);
+		nvgMiterLimit(args.vg, 1.0f);
+		nvgStrokeWidth(args.vg, 0.7f);
+		int colorIndex = 0;
+		for (int t = 0; t < 24; t++) {
+			if ((*spectrumOverlaySrc & (1 << t)) == 0 || t == currTrk) continue;
+			SpectrumAnalyzer* overlaySpectrum = overlaySpectrumsSrc[t];
+			int overlaySize = overlaySpectrum->drawBufSize;
+			if (overlaySize <= 0) continue;
+			const float* overlayBuf = overlaySpectrum->drawBuf;
+			NVGcolor strokecol = DISP_COLORS[2 + (colorIndex % (numDispThemes - 2))];
+			strokecol.a = 0.7f;
+			nvgStrokeColor(args.vg, strokecol);
+			colorIndex++;
+			
+			nvgBeginPath(args.vg);
+			nvgMoveTo(args.vg, -1.0f, box.size.y - overlayBuf[1]);// same cheat as in drawSpectrum() for the first freq
+			for (int x = 2; x < overlaySize; x++) {	
+				nvgLineTo(args.vg, overlayBuf[x + FFT_N_2], box.size.y - overlayBuf[x]);
+			}
+			nvgStroke(args.vg);
+		}
+	}
+
 	
 	// eq curves
 	void calcCurveData() {
@@ -0,0 +1,362 @@
+//***********************************************************************************************
+//Mixer module for VCV Rack by Steve Baker and Marc Boul
+//
+//Based on code from the Fundamental plugin by Andrew Belt
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+
+#pragma once
+
+#include "EqMasterCommon.hpp"
+#include "dsp/fft.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+// Spectrum analysis shared by all EqMasters: one pool of worker threads, and one PFFFT setup and window per FFT size,
+// for any number of analyzers (one per analyzed track, of any EqMaster).
+// An analyzer is written by the engine thread a sample at a time, is handed to the pool each time a page of samples is ready,
+// and its drawBuf is read by the UI thread. The worker threads only run while there is at least one analyzer, 
+// and the second worker is only started once there is more than one analyzer.
+
+
+struct SpectrumFft {// shared by all the analyzers of the same FFT size
+	int fftN;
+	int refCount;
+	PFFFT_Setup* ffts;// https://bitbucket.org/jpommier/pffft/src/default/test_pffft.c
+	float* windowFunc;//[fftN / 2] precomputed window function for FFT; function is symetrical, so only first half of window is actually stored here
+
+	SpectrumFft(int _fftN) {
+		fftN = _fftN;
+		refCount = 0;
+		ffts = pffft_new_setup(fftN, PFFFT_REAL);
+		windowFunc = static_cast<float*>(pffft_aligned_malloc((fftN >> 1) * 4));
+		for (int i = 0; i < ((fftN >> 1) / 4); i++) {
+			simd::float_4 p = {(float)(i * 4 + 0), (float)(i * 4 + 1), (float)(i * 4 + 2), (float)(i * 4 + 3)};
+			p /= (float)(fftN - 1);
+			p = dsp::blackmanHarris<simd::float_4>(p);
+			p.store(&(windowFunc[i * 4]));
+		}
+	}
+
+	~SpectrumFft() {
+		pffft_destroy_setup(ffts);
+		pffft_aligned_free(windowFunc);
+	}
+};
+
+
+struct SpectrumAnalyzer {
+	enum StateIds {STATE_IDLE, STATE_REQUESTED, STATE_BUSY};
+
+	// set by the owner (engine thread), used by the worker when the page is processed
+	float sampleRate = 44100.0f;
+	float decayFactor = 0.0f;// see SpectrumService::noDecay
+
+	// engine thread
+	int fftWriteHead;
+	int page;
+	int requestPage;
+	float* fftIn[3];
+
+	// worker thread
+	float* drawBufLin;//[fftN / 2] store lin magnitude, used for calculating decay (normally this is compacted freq bins, so not all array used)
+
+	// read by UI thread
+	float* drawBuf;//[fftN] store log magnitude only in first half, log freq in second half (normally this is compacted freq bins, so not all array used)
+	int drawBufSize;// -1 when no data to draw
+
+	// other
+	SpectrumFft* fft;
+	std::atomic<int> state;
+
+
+	SpectrumAnalyzer(SpectrumFft* _fft) {
+		fft = _fft;
+		int fftN = fft->fftN;
+		fftIn[0] = static_cast<float*>(pffft_aligned_malloc(fftN * 4));
+		fftIn[1] = static_cast<float*>(pffft_aligned_malloc(fftN * 4));
+		fftIn[2] = static_cast<float*>(pffft_aligned_malloc(fftN * 4));
+		drawBuf = static_cast<float*>(pffft_aligned_malloc(fftN * 4));
+		drawBufLin = static_cast<float*>(pffft_aligned_malloc((fftN >> 1) * 4));
+		for (int i = 0; i < (fftN >> 1); i++) {
+			drawBuf[i] = -1.0f;
+			drawBufLin[i] = 0.0f;
+		}
+		state = STATE_IDLE;
+		requestPage = 0;
+		reset();
+	}
+
+	~SpectrumAnalyzer() {
+		pffft_aligned_free(fftIn[0]);
+		pffft_aligned_free(fftIn[1]);
+		pffft_aligned_free(fftIn[2]);
+		pffft_aligned_free(drawBuf);
+		pffft_aligned_free(drawBufLin);
+	}
+
+	void reset() {
+		fftWriteHead = 0;
+		page = 0;
+		drawBufSize = -1;
+	}
+
+	void restart() {// when no samples are written (analyzer off), so that the next page starts from an empty window
+		fftWriteHead = 0;
+		page = 0;
+	}
+
+
+	// engine thread, returns true when a page is ready for the pool, see SpectrumService::write()
+	bool write(float sample) {
+		int fftN = fft->fftN;
+		int fftN_2 = fftN >> 1;
+		const float* windowFunc = fft->windowFunc;
+
+		// write sample into fft input buffers and apply windowing
+		fftIn[page][fftWriteHead] = sample * windowFunc[fftWriteHead >= fftN_2 ? ((fftN - 1) - fftWriteHead) : fftWriteHead];
+		if (fftWriteHead >= fftN_2) {
+			int offsetHead = fftWriteHead - fftN_2;
+			fftIn[(page + 1) % 3][offsetHead] = sample * windowFunc[offsetHead];
+		}
+
+		// increment write head and possibly page
+		fftWriteHead++;
+		if (fftWriteHead >= fftN) {
+			fftWriteHead = fftN_2;
+			bool ret = false;
+			if (state.load(std::memory_order_acquire) == STATE_IDLE) {// else FFT too slow, page skipped
+				requestPage = page;
+				state.store(STATE_REQUESTED, std::memory_order_release);
+				ret = true;
+			}
+			page++;
+			if (page >= 3) {
+				page = 0;
+			}
+			return ret;
+		}
+		return false;
+	}
+};
+
+
+struct SpectrumService {
+	static const int NUM_WORKERS = 2;// at most
+	static const int WORKER_POLL_MS = 5;// see write()
+	static constexpr float noDecay = 1000.0f;
+	static constexpr float vertScaling = 1.1f;
+	static constexpr float vertOffset = 10.0f;
+
+	// subscribe() and unsubscribe() are serialized by subscribeMutex, so that the pool is never started while it stops,
+	// and all allocations are done under subscribeMutex only; the engine thread takes no lock, see write()
+	std::mutex subscribeMutex;// for ffts and workers
+	std::vector<SpectrumFft*> ffts;
+	std::vector<std::thread> workers;
+	std::mutex m;// for the members below
+	std::condition_variable cv;// https://thispointer.com//c11-multithreading-part-7-condition-variables-explained/
+	std::vector<SpectrumAnalyzer*> analyzers;
+	bool requestStop = false;
+	std::atomic<int> numRequests = {0};// analyzers in STATE_REQUESTED, counted up by the engine thread without m (so it can be -1 for
+	// a moment, when a worker takes a page before the engine thread has counted it)
+
+
+	// UI thread (or module constructor), allocates the analyzer, and starts the pool with the first analyzer
+	SpectrumAnalyzer* subscribe(int fftN) {
+		std::lock_guard<std::mutex> lkSubscribe(subscribeMutex);
+		SpectrumFft* fft = nullptr;
+		for (SpectrumFft* f : ffts) {
+			if (f->fftN == fftN) {
+				fft = f;
+				break;
+			}
+		}
+		if (fft == nullptr) {
+			fft = new SpectrumFft(fftN);
+			ffts.push_back(fft);
+		}
+		fft->refCount++;
+		SpectrumAnalyzer* analyzer = new SpectrumAnalyzer(fft);
+		std::unique_lock<std::mutex> lk(m);
+		analyzers.push_back(analyzer);
+		int numAnalyzers = (int)analyzers.size();
+		lk.unlock();
+		if ((int)workers.size() < std::min(numAnalyzers, NUM_WORKERS)) {
+			startWorker(fftN);
+		}
+		return analyzer;
+	}
+
+
+	// UI thread (or module destructor), the engine thread must no longer write into the analyzer; stops the pool with the last analyzer
+	void unsubscribe(SpectrumAnalyzer* analyzer) {
+		std::lock_guard<std::mutex> lkSubscribe(subscribeMutex);
+		std::unique_lock<std::mutex> lk(m);
+		analyzers.erase(std::remove(analyzers.begin(), analyzers.end(), analyzer), analyzers.end());
+		int requested = SpectrumAnalyzer::STATE_REQUESTED;
+		if (analyzer->state.compare_exchange_strong(requested, SpectrumAnalyzer::STATE_IDLE)) {
+			numRequests--;
+		}
+		bool lastAnalyzer = analyzers.empty();
+		lk.unlock();
+		while (analyzer->state.load(std::memory_order_acquire) == SpectrumAnalyzer::STATE_BUSY) {
+			std::this_thread::yield();
+		}
+		SpectrumFft* fft = analyzer->fft;
+		delete analyzer;
+		fft->refCount--;
+		if (fft->refCount == 0) {
+			ffts.erase(std::remove(ffts.begin(), ffts.end(), fft), ffts.end());
+			delete fft;
+		}
+		if (lastAnalyzer) {
+			stopWorkers();
+		}
+	}
+
+
+	~SpectrumService() {
+		std::lock_guard<std::mutex> lkSubscribe(subscribeMutex);
+		stopWorkers();
+	}
+
+
+	void startWorker(int fftN) {// with subscribeMutex locked
+		if (workers.empty()) {
+			std::unique_lock<std::mutex> lk(m);
+			requestStop = false;
+			lk.unlock();
+		}
+		workers.push_back(std::thread(&SpectrumService::worker_thread, this, fftN));
+	}
+	void stopWorkers() {// with subscribeMutex locked
+		std::unique_lock<std::mutex> lk(m);
+		requestStop = true;
+		lk.unlock();
+		cv.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		workers.clear();
+	}
+
+
+	// engine thread, writes a sample into the analyzer and hands it to the pool when a page is ready
+	void write(SpectrumAnalyzer* analyzer, float sample) {
+		if (analyzer->write(sample)) {
+			// no lock here, so the engine thread never waits on a worker or the UI; a notify that comes while a worker 
+			// is between its check of numRequests and its wait is lost, but the worker checks again after WORKER_POLL_MS
+			numRequests.fetch_add(1, std::memory_order_release);
+			cv.notify_one();
+		}
+	}
+
+
+	void worker_thread(int fftN) {
+		// scratch buffer for the transform and the magnitudes, grown when an analyzer of a larger FFT size is processed
+		int fftOutSize = fftN;
+		float* fftOut = static_cast<float*>(pffft_aligned_malloc(fftOutSize * 4));
+
+		std::unique_lock<std::mutex> lk(m);
+		while (true) {
+			// sleeps until a page is requested or the pool stops
+			cv.wait_for(lk, std::chrono::milliseconds(WORKER_POLL_MS), [this] {return requestStop || numRequests.load(std::memory_order_acquire) > 0;});
+			if (requestStop) break;
+
+			SpectrumAnalyzer* analyzer = nullptr;
+			for (SpectrumAnalyzer* a : analyzers) {
+				int requested = SpectrumAnalyzer::STATE_REQUESTED;
+				if (a->state.compare_exchange_strong(requested, SpectrumAnalyzer::STATE_BUSY)) {
+					analyzer = a;
+					numRequests--;
+					break;
+				}
+			}
+			if (analyzer == nullptr) continue;
+			lk.unlock();
+
+			if (analyzer->fft->fftN > fftOutSize) {
+				pffft_aligned_free(fftOut);
+				fftOutSize = analyzer->fft->fftN;
+				fftOut = static_cast<float*>(pffft_aligned_malloc(fftOutSize * 4));
+			}
+			processPage(analyzer, fftOut);
+			analyzer->state.store(SpectrumAnalyzer::STATE_IDLE, std::memory_order_release);
+
+			lk.lock();
+		}
+		lk.unlock();
+		pffft_aligned_free(fftOut);
+	}
+
+
+	static void processPage(SpectrumAnalyzer* a, float* fftOut) {
+		int fftN = a->fft->fftN;
+		int fftN_2 = fftN >> 1;
+		float* drawBuf = a->drawBuf;
+		float* drawBufLin = a->drawBufLin;
+
+		// compute fft
+		pffft_transform_ordered(a->fft->ffts, a->fftIn[a->requestPage], fftOut, NULL, PFFFT_FORWARD);
+
+		// calculate magnitude and store in 1st half of array
+		for (int x = 0; x < fftN ; x += 2) {
+			fftOut[x >> 1] = fftOut[x + 0] * fftOut[x + 0] + fftOut[x + 1] * fftOut[x + 1];// sqrt is not needed in magnitude calc since when take log of this, it can be absorbed in scaling multiplier
+		}
+
+		// calculate pixel scaled log of frequency and store in 2nd half of array
+		for (int x = 0; x < fftN_2 / 4 ; x++) {
+			int xt4 = x << 2;
+			simd::float_4 vecp(xt4 + 0, xt4 + 1, xt4 + 2, xt4 + 3);
+			vecp = (vecp / ((float)(fftN - 1))) * a->sampleRate;// linear freq a this line
+			vecp = simd::round(simd::rescale(simd::log10(vecp), minLogFreq, maxLogFreq, 0.0f, eqCurveWidth));// pixel scaled log freq at this line
+			vecp.store(&fftOut[xt4 + fftN_2]);
+		}
+
+		// compact frequency bins
+		int i = 1;// index into compacted bins
+		drawBuf[fftN_2] = fftOut[fftN_2];
+		for (int x = 1; x < fftN_2 ; x++) {// index into non-compacted bins
+			if (drawBuf[i - 1 + fftN_2] == fftOut[x + fftN_2]) {
+				fftOut[i - 1] = std::fmax(fftOut[i - 1], fftOut[x]);
+			}
+			else {
+				fftOut[i] = fftOut[x];
+				drawBuf[i + fftN_2] = fftOut[x + fftN_2];
+				i++;
+			}
+		}
+		int compactedSize = i;
+
+		// decay
+		float decayFactor = a->decayFactor;
+		if (decayFactor != noDecay) {
+			for (i = 0; i < compactedSize; i++) {
+				if (fftOut[i] > drawBufLin[i]) {
+					drawBufLin[i] = fftOut[i];
+				}
+				else {
+					drawBufLin[i] += (fftOut[i] - drawBufLin[i]) * decayFactor * fftN_2 / a->sampleRate;// decay
+				}
+			}
+		}
+		else {
+			memcpy(&drawBufLin[0], &fftOut[0], compactedSize * 4);
+		}
+
+		// calculate log of magnitude and transfer to drawBuf
+		for (int x = 0; x < ((compactedSize + 3) >> 2) ; x++) {
+			simd::float_4 vecp = simd::float_4::load(&drawBufLin[x << 2]);
+			vecp = simd::fmax(vertScaling * 20.0f * simd::log10(vecp) + vertOffset, -1.0f);// fmax for proper enclosed region for fill
+			vecp.store(&drawBuf[x << 2]);
+		}
+
+		a->drawBufSize = compactedSize;
+	}
+};
+
+
+extern SpectrumService spectrumService;
@@ -35,6 +35,7 @@ void init(Plugin *p) {
 	p->addModel(modelAuxExpanderJr);
 	p->addModel(modelMixMaster);
 	p->addModel(modelAuxExpander);
+	p->addModel(modelMixMaster32);
 }
 
 
@@ -47,6 +48,7 @@ void init(Plugin *p) {
 // Global settings
 
 int8_t pmAllowMouseTileMove = 0;
+int8_t mmSaveLegacyStripKeys = 0;
 
 
 
@@ -57,6 +59,7 @@ void readGlobalSettings() {
 	FILE *file = fopen(settingsFilename.c_str(), "r");
 	if (!file) {
 		pmAllowMouseTileMove = 0;
+		mmSaveLegacyStripKeys = 0;
 		writeGlobalSettings();
 		return;
 	}
@@ -66,6 +69,7 @@ void readGlobalSettings() {
 		// invalid setting json file
 		fclose(file);
 		pmAllowMouseTileMove = 0;
+		mmSaveLegacyStripKeys = 0;
 		writeGlobalSettings();
 		return;
 	}
@@ -79,6 +83,15 @@ void readGlobalSettings() {
 		pmAllowMouseTileMove = 0;
 	}
 	
+	// mmSaveLegacyStripKeys
+	json_t *mmSaveLegacyStripKeysJ = json_object_get(settingsJ, "mmSaveLegacyStripKeys");
+	if (mmSaveLegacyStripKeysJ) {
+		mmSaveLegacyStripKeys = json_integer_value(mmSaveLegacyStripKeysJ);
+	}
+	else {
+		mmSaveLegacyStripKeys = 0;
+	}
+	
 	fclose(file);
 	json_decref(settingsJ);
 	return;
@@ -90,6 +103,9 @@ void writeGlobalSettings() {
 	
 	// pmAllowMouseTileMove
 	json_object_set_new(settingsJ, "pmAllowMouseTileMove", json_integer(pmAllowMouseTileMove));
+	
+	// mmSaveLegacyStripKeys
+	json_object_set_new(settingsJ, "mmSaveLegacyStripKeys", json_integer(mmSaveLegacyStripKeys));
 		
 	std::string settingsFilename = asset::user("MindMeldModular.json");
 	FILE *file = fopen(settingsFilename.c_str(), "w");
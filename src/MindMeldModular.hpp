@@ -41,6 +41,7 @@ extern Model *modelMixMasterJr;
 extern Model *modelAuxExpanderJr;
 extern Model *modelMixMaster;
 extern Model *modelAuxExpander;
+extern Model *modelMixMaster32;
 
 
 // General constants
@@ -52,6 +53,7 @@ extern Model *modelAuxExpander;
 // Global settings
 
 extern int8_t pmAllowMouseTileMove;// PatchMaster allow ctrl/cmd click to move tiles
+extern int8_t mmSaveLegacyStripKeys;// MixMaster and AuxSpander also save their strips in the per-strip keys of the versions before the blobs
 
 
 
@@ -226,16 +228,19 @@ struct DispTwoColorItem : MenuItem {
 // poly stereo menu item
 struct PolyStereoItem : MenuItem {
 	int8_t *polyStereoSrc = nullptr;
+	std::function<void()> onChange;// optional, called when the setting changes
 
 	Menu *createChildMenu() override {
 		Menu *menu = new Menu;
 		menu->addChild(createCheckMenuItem("Sum each input (L, R)", "",
 			[=]() {return *polyStereoSrc == 0;},
-			[=]() {*polyStereoSrc = 0;}
+			[=]() {*polyStereoSrc = 0;
+				   if (onChange) onChange();}
 		));
 		menu->addChild(createCheckMenuItem("Sum to stereo (L only)", "",
 			[=]() {return *polyStereoSrc == 1;},
-			[=]() {*polyStereoSrc = 1;}
+			[=]() {*polyStereoSrc = 1;
+				   if (onChange) onChange();}
 		));
 		return menu;
 	}
@@ -255,6 +260,13 @@ inline void togglePmAllowMouseTileMove() {
 	pmAllowMouseTileMove ^= 0x1;
 	writeGlobalSettings();
 }
+inline bool isMmSaveLegacyStripKeys() {
+	return mmSaveLegacyStripKeys != 0;
+}
+inline void toggleMmSaveLegacyStripKeys() {
+	mmSaveLegacyStripKeys ^= 0x1;
+	writeGlobalSettings();
+}
 
 
 // sort the 4 floats in a float_4 in ascending order starting with index 0
@@ -358,6 +370,40 @@ static inline void applyStereoWidth(float width, float* left, float* right) {
 }
 
 
+static inline void sumPolyStereo(Input* in, float* left, float* right) {
+	// poly stereo: sums all odd numbered channels into left, even numbered into right (1-indexed)
+	// the voltages are summed four at a time, so the sum is L R L R, and unused channels are masked since they can hold old voltages
+	const float* voltages = in->getVoltages();
+	int numChan = in->getChannels();
+	simd::float_4 chanNum = simd::float_4(0.0f, 1.0f, 2.0f, 3.0f);
+	simd::float_4 sum = simd::float_4::zero();
+	for (int c = 0; c < numChan; c += 4) {
+		sum += simd::ifelse(chanNum < (float)numChan, simd::float_4::load(&voltages[c]), 0.0f);
+		chanNum += 4.0f;
+	}
+	// add the upper L R pair to the lower one
+	sum += simd::float_4(_mm_shuffle_ps(sum.v, sum.v, _MM_SHUFFLE(1, 0, 3, 2)));
+	*left = sum[0];
+	*right = sum[1];
+}
+
+
+// gain helpers for the audio path, the menus and the param displays keep std::pow()
+// dB to linear, as 2^(dB * log2(10) / 20) with Rack's 5th order approximation (6e-6 relative error at most)
+template<typename T>
+static inline T dbToLinearFast(T db) {
+	return dsp::exp2_taylor5(db * T(0.16609640f));
+}
+// x^e for the small integer fader scaling exponents (GlobalConst::*ScalingExponent), as multiplies instead of a pow() call
+static inline float powInt(float x, int e) {
+	float ret = x;
+	for (int i = 1; i < e; i++) {
+		ret *= x;
+	}
+	return ret;
+}
+
+
 static inline float clampNothing(float in) {// meant to catch invalid values like -inf, +inf, strong overvoltage only. Not needed anymore since Rack2 has invalid value protection on outputs
 	return in;
 	// if (in >= -20.0f && in <= 20.0f) {
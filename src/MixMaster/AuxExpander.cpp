@@ -48,13 +48,16 @@ struct AuxExpander : Module {
 	};
 	
 	typedef TAfmExpInterface<N_TRK, N_GRP> AfmExpInterface;
+	typedef TAfmExpFast<N_TRK, N_GRP> AfmExpFast;
+	typedef TAfmExpSlow<N_TRK, N_GRP> AfmExpSlow;
 	
 	
 	#include "AuxExpander.hpp"
+	#include "AuxSendBank.hpp"
 	
 
 	// Expander
-	AfmExpInterface leftMessages[2];// messages from mother (first index is page), see enum called AuxFromMotherIds in MixerCommon.hpp
+	AfmExpInterface leftMessages;// messages from mother, written in place by the mother, see MixerCommon.hpp
 
 
 	// Constants
@@ -93,11 +96,13 @@ struct AuxExpander : Module {
 	float globalRetPansWithCV[4];
 	bool globalRetPansCvConnected;
 	TSlewLimiterSingle<simd::float_4> sendMuteSlewers[N_TRK / 4 + 1];
-	simd::float_4 trackSendVcaGains[N_TRK];
-	simd::float_4 groupSendVcaGains[N_GRP];
+	AuxSendBank sendBank;// send gains of all tracks and groups
+	uint32_t sendGainsDirty;// one bit per track then group, set when its gains in sendBank must be recomputed
+	simd::float_4 sendKnobsOld[N_TRK + N_GRP];// aux send knobs of each track and group when its gains were last computed
 	
 	// No need to save, no reset
 	RefreshCounter refresh;	
+	EcoMeter ecoMeter;// cost of process(), sent to the mother for its adaptive eco mode
 	bool motherPresent = false;// can't be local to process() since widget must know in order to properly draw border
 	float maxAGIndivSendFader;
 	float maxAGGlobSendFader;
@@ -121,8 +126,8 @@ struct AuxExpander : Module {
 	AuxExpander() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);		
 		
-		leftExpander.producerMessage = &leftMessages[0];
-		leftExpander.consumerMessage = &leftMessages[1];
+		leftExpander.producerMessage = &leftMessages;
+		leftExpander.consumerMessage = &leftMessages;// same transport, never flipped
 		
 		char strBuf[32];
 		maxAGIndivSendFader = std::pow(GlobalConst::individualAuxSendMaxLinearGain, 1.0f / GlobalConst::individualAuxSendScalingExponent);
@@ -210,12 +215,6 @@ struct AuxExpander : Module {
 		for (int i = 0; i < (N_TRK / 4 + 1); i++) {
 			sendMuteSlewers[i].setRiseFall(simd::float_4(GlobalConst::antipopSlewFast)); // slew rate is in input-units per second (ex: V/s)
 		}
-		for (int i = 0; i < N_TRK; i++) {
-			trackSendVcaGains[i] = simd::float_4::zero();
-		}
-		for (int i = 0; i < N_GRP; i++) {
-			groupSendVcaGains[i] = simd::float_4::zero();
-		}
 		auxLabels[4 * 4] = 0;
 		
 		aux.reserve(4);
@@ -256,6 +255,7 @@ struct AuxExpander : Module {
 		}
 		globalSendsCvConnected = false;
 		indivGroupSendCvConnected = false;
+		sendGainsDirty = (1 << (N_TRK + N_GRP)) - 1;
 		globalRetPansCvConnected = false;
 		for (int i = 0; i < (N_TRK / 4 + 1); i++) {
 			sendMuteSlewers[i].reset();
@@ -318,9 +318,18 @@ struct AuxExpander : Module {
 		// auxLabels
 		json_object_set_new(rootJ, "auxLabels", json_string(auxLabels));
 		
-		// aux
+		// aux, in one blob
+		SettingsBlob blob;
+		blob.put(SettingsBlob::VERSION);
 		for (int i = 0; i < 4; i++) {
-			aux[i].dataToJson(rootJ);
+			aux[i].dataToBlob(&blob);
+		}
+		json_object_set_new(rootJ, "auxBlob", json_string(blob.toBase64().c_str()));
+		// aux again in per-strip keys, only when asked for in MixMaster's menu (see MixMaster::dataToJson())
+		if (isMmSaveLegacyStripKeys()) {
+			for (int i = 0; i < 4; i++) {
+				aux[i].dataToJson(rootJ);
+			}
 		}
 
 		// panCvLevels
@@ -410,8 +419,11 @@ struct AuxExpander : Module {
 		}
 
 		// aux
-		for (int i = 0; i < 4; i++) {
-			aux[i].dataFromJson(rootJ);
+		if (!auxFromBlob(rootJ)) {
+			// per-aux keys, as saved before the blob
+			for (int i = 0; i < 4; i++) {
+				aux[i].dataFromJson(rootJ);
+			}
 		}
 
 		// panCvLevels
@@ -427,6 +439,31 @@ struct AuxExpander : Module {
 
 		resetNonJson(true);
 	}
+	bool auxFromBlob(json_t *rootJ) {// returns false when there is no blob or when it can't be read
+		json_t *blobJ = json_object_get(rootJ, "auxBlob");
+		if (!blobJ) {
+			return false;
+		}
+		SettingsBlob blob;
+		if (!blob.fromBase64(json_string_value(blobJ))) {
+			WARN("AuxSpander: error decoding auxBlob");
+			return false;
+		}
+		uint8_t version = 0;
+		blob.get(&version);
+		if (blob.error || version != SettingsBlob::VERSION) {
+			WARN("AuxSpander: error auxBlob version %i not supported", (int)version);
+			return false;
+		}
+		if (!blob.checkRecords(4)) {// nothing is loaded from a blob that is cut short, the keys are used instead
+			WARN("AuxSpander: error auxBlob truncated");
+			return false;
+		}
+		for (int i = 0; i < 4; i++) {
+			aux[i].dataFromBlob(&blob);
+		}
+		return true;
+	}
 
 
 	void swapCopyToClipboard() {
@@ -544,11 +581,12 @@ struct AuxExpander : Module {
 	
 
 	void process(const ProcessArgs &args) override {
+		uint16_t ecoMeterCounter = refresh.refreshCounter;
+		bool ecoMeterTimed = ecoMeter.begin(ecoMeterCounter);
 		
+		bool motherWasPresent = motherPresent;
 		motherPresent = (leftExpander.module && leftExpander.module->model == (N_TRK == 16 ? modelMixMaster : modelMixMasterJr));
 		
-		AfmExpInterface *messagesFromMother = static_cast<AfmExpInterface*>(leftExpander.consumerMessage);
-		
 		if (refresh.processInputs()) {
 			processMuteSoloCvTriggers();
 		}// userInputs refresh
@@ -557,61 +595,72 @@ struct AuxExpander : Module {
 			// From Mother
 			// ***********
 			
-			// Slow values from mother
-			if (messagesFromMother->updateSlow) {
-				colorAndCloak.cc1 = messagesFromMother->colorAndCloak.cc1;
-				directOutPanStereoMomentCvLinearVol.cc1 = messagesFromMother->directOutPanStereoMomentCvLinearVol.cc1;
-				muteAuxSendWhenReturnGrouped = messagesFromMother->muteAuxSendWhenReturnGrouped;
+			// Slow values from mother (only when they changed)
+			AfmExpSlow *slowFromMother = leftMessages.slowToRead(args.frame);
+			if (slowFromMother) {
+				colorAndCloak.cc1 = slowFromMother->colorAndCloak.cc1;
+				directOutPanStereoMomentCvLinearVol.cc1 = slowFromMother->directOutPanStereoMomentCvLinearVol.cc1;
+				if (muteAuxSendWhenReturnGrouped != slowFromMother->muteAuxSendWhenReturnGrouped) {
+					sendGainsDirty |= ((1 << N_GRP) - 1) << N_TRK;
+				}
+				muteAuxSendWhenReturnGrouped = slowFromMother->muteAuxSendWhenReturnGrouped;
 				for (int i = 0; i < N_TRK; i++) {
 					lights[AUXSENDMUTE_GROUPED_RETURN_LIGHTS + i].setBrightness((muteAuxSendWhenReturnGrouped & (1 << i)) != 0 ? 1.0f : 0.0f);
 				}
-				ecoMode = messagesFromMother->ecoMode;
-				if (messagesFromMother->trackMoveInAuxRequest != 0) {
-					moveTrack(messagesFromMother->trackMoveInAuxRequest);
-					messagesFromMother->trackMoveInAuxRequest = 0;
+				ecoMode = slowFromMother->ecoMode;
+				if (slowFromMother->trackMoveInAuxRequest != 0) {
+					moveTrack(slowFromMother->trackMoveInAuxRequest);
 				}
-				if (messagesFromMother->trackOrGroupResetInAux != -1) {
-					resetTrackOrGroup(messagesFromMother->trackOrGroupResetInAux);
-					messagesFromMother->trackOrGroupResetInAux = -1;
+				if (slowFromMother->trackOrGroupResetInAux != -1) {
+					resetTrackOrGroup(slowFromMother->trackOrGroupResetInAux);
 				}
-				memcpy(trackLabels, messagesFromMother->trackLabels, 4 * (N_TRK + N_GRP));
+				memcpy(trackLabels, slowFromMother->trackLabels, 4 * (N_TRK + N_GRP));
 				updateTrackLabelRequest = 1;
-				if (messagesFromMother->colorAndCloak.cc4[dispColorGlobal] >= numDispThemes) {
-					memcpy(trackDispColsLocal, messagesFromMother->trackDispColsLocal, (N_TRK / 4 + 1) * 4);
+				if (slowFromMother->colorAndCloak.cc4[dispColorGlobal] >= numDispThemes) {
+					memcpy(trackDispColsLocal, slowFromMother->trackDispColsLocal, (N_TRK / 4 + 1) * 4);
 				}
-				memcpy(auxRetFadeGains, messagesFromMother->auxRetFadeGains, 4 * 4);
-				memcpy(srcMuteGhost, messagesFromMother->srcMuteGhost, 4 * 4);
-				if (messagesFromMother->globalToLocalOp.opCodeExpander != GTOL_NOP) {
-					doGlobalToLocalOp(messagesFromMother->globalToLocalOp.opCodeExpander, messagesFromMother->globalToLocalOp.operand);
+				memcpy(auxRetFadeGains, slowFromMother->auxRetFadeGains, 4 * 4);
+				memcpy(srcMuteGhost, slowFromMother->srcMuteGhost, 4 * 4);
+				if (slowFromMother->globalToLocalOp.opCodeExpander != GTOL_NOP) {
+					doGlobalToLocalOp(slowFromMother->globalToLocalOp.opCodeExpander, slowFromMother->globalToLocalOp.operand);
 				}
 			}
 			
-			// Fast values from mother
+			// Fast values from mother (the mother is writing into the other slot)
+			AfmExpFast *fastFromMother = leftMessages.fastToRead(args.frame);
 			// Vus 
-			int value4i = clamp(messagesFromMother->vuIndex, 0, 4);
-			memcpy(&srcLevelsVus[value4i][0], messagesFromMother->vuValues, 4 * 4);
+			int value4i = clamp(fastFromMother->vuIndex, 0, 4);
+			memcpy(&srcLevelsVus[value4i][0], fastFromMother->vuValues, 4 * 4);
 
 						
 			// Aux sends
 
 			// Prepare values used to compute aux sends
+			// ecoMask follows the control-rate divider of the mother, capped at 1/4 since refreshCounter20 cycles over 20
+			uint16_t ecoMask = (ecoMode & 0x3);
 			//   Global aux send knobs (4 instances)
-			if (ecoMode == 0 || (refreshCounter20 & 0x3) == 0) {// stagger 0
+			if ((refreshCounter20 & ecoMask) == 0) {// stagger 0
+				simd::float_4 newGlobalSends;
 				for (int gi = 0; gi < 4; gi++) {
-					globalSends[gi] = params[GLOBAL_AUXSEND_PARAMS + gi].getValue();
+					newGlobalSends[gi] = params[GLOBAL_AUXSEND_PARAMS + gi].getValue();
 				}
 				globalSendsCvConnected = inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].isConnected();
 				if (globalSendsCvConnected) {
 					// Knob CV (adding, pre-scaling)
 					simd::float_4 cvVoltages(inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].getVoltage(0), inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].getVoltage(1),
 					inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].getVoltage(2), inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].getVoltage(3));
-					globalSends += cvVoltages * 0.1f * maxAGGlobSendFader;
+					newGlobalSends += cvVoltages * 0.1f * maxAGGlobSendFader;
 					// lines above replace commented line below since templating AuxExpander broke it for some strange reason
-					// globalSends += (inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].getVoltageSimd<simd::float_4>(0)) * 0.1f * maxAGGlobSendFader;
-					globalSends = clamp(globalSends, 0.0f, maxAGGlobSendFader);
-					globalSendsWithCV = globalSends;// can put here since unused when cv disconnected
+					// newGlobalSends += (inputs[POLY_BUS_SND_PAN_RET_CV_INPUT].getVoltageSimd<simd::float_4>(0)) * 0.1f * maxAGGlobSendFader;
+					newGlobalSends = clamp(newGlobalSends, 0.0f, maxAGGlobSendFader);
+					globalSendsWithCV = newGlobalSends;// can put here since unused when cv disconnected
+				}
+				newGlobalSends = simd::pow<simd::float_4>(newGlobalSends, GlobalConst::globalAuxSendScalingExponent);
+				if (movemask(newGlobalSends == globalSends) != 0xF) {
+					// global sends scale the gains of all tracks and groups
+					sendGainsDirty = (1 << (N_TRK + N_GRP)) - 1;
+					globalSends = newGlobalSends;
 				}
-				globalSends = simd::pow<simd::float_4>(globalSends, GlobalConst::globalAuxSendScalingExponent);
 			
 				//   Indiv mute sends (20 or 10 instances)				
 				for (int gi = 0; gi < (N_TRK + N_GRP); gi++) {
@@ -620,24 +669,42 @@ struct AuxExpander : Module {
 				for (int gi = 0; gi < (N_TRK / 4 + 1); gi++) {
 					muteSends[gi] = simd::ifelse(muteSends[gi] >= 0.5f, 0.0f, 1.0f);
 					if (movemask(muteSends[gi] == sendMuteSlewers[gi].out) != 0xF) {// movemask returns 0xF when 4 floats are equal
-						sendMuteSlewers[gi].process(args.sampleTime * (1 + (ecoMode & 0x3)), muteSends[gi]);
+						sendMuteSlewers[gi].process(args.sampleTime * (1 + ecoMask), muteSends[gi]);
+						sendGainsDirty |= (0xF << (gi << 2)) & ((1 << (N_TRK + N_GRP)) - 1);// the 4 tracks (or the groups) of this slewer
 					}
 				}
 			}
 	
 			// Aux send VCAs
-			float* auxSendsTrkGrp = messagesFromMother->auxSends;// 40 values of the sends (Trk1L, Trk1R, Trk2L, Trk2R ... Trk16L, Trk16R, Grp1L, Grp1R ... Grp4L, Grp4R))
-			simd::float_4 auxSends[2] = {simd::float_4::zero(), simd::float_4::zero()};// [0] = ABCD left, [1] = ABCD right
-			// accumulate tracks
-			for (int trk = 0; trk < N_TRK; trk++) {
-				// prepare trackSendVcaGains when needed
-				if (ecoMode == 0 || (refreshCounter20 & 0x3) == 1) {// stagger 1			
-					for (int auxi = 0; auxi < 4; auxi++) {
+			// the gains of a track or group are only recomputed when its knobs moved, when a cv is connected to them, 
+			// or when sendGainsDirty was set by the global sends, the mute slewers or the grouped return mutes
+			// prepare the track send gains when needed
+			if ((refreshCounter20 & ecoMask) == (1 & ecoMask)) {// stagger 1			
+				bool anyCvConnected = false;
+				for (int auxi = 0; auxi < 4; auxi++) {
+					bool cvConnected = inputs[POLY_AUX_AD_CV_INPUTS + (auxi >> (N_GRP == 4 ? 0 : 1))].isConnected();
+					if (cvConnected != indivTrackSendCvConnected[auxi]) {
+						sendGainsDirty |= (1 << N_TRK) - 1;// an unplugged cv must not be left in the gains
+					}
+					indivTrackSendCvConnected[auxi] = cvConnected;
+					anyCvConnected |= cvConnected;
+				}
+				for (int trk = 0; trk < N_TRK; trk++) {
 					// 64 (32) individual track aux send knobs
-						float val = params[TRACK_AUXSEND_PARAMS + (trk << 2) + auxi].getValue();
+					simd::float_4 sendKnobs;
+					for (int auxi = 0; auxi < 4; auxi++) {
+						sendKnobs[auxi] = params[TRACK_AUXSEND_PARAMS + (trk << 2) + auxi].getValue();
+					}
+					if (!anyCvConnected && (sendGainsDirty & (1 << trk)) == 0 && movemask(sendKnobs == sendKnobsOld[trk]) == 0xF) {
+						continue;
+					}
+					sendKnobsOld[trk] = sendKnobs;
+					sendGainsDirty &= ~(1 << trk);
+					simd::float_4 trackSendVcaGains;
+					for (int auxi = 0; auxi < 4; auxi++) {
+						float val = sendKnobs[auxi];
 						int inputNum = POLY_AUX_AD_CV_INPUTS + (auxi >> (N_GRP == 4 ? 0 : 1));
-						indivTrackSendCvConnected[auxi] = inputs[inputNum].isConnected();
-						if (inputs[inputNum].isConnected()) {
+						if (indivTrackSendCvConnected[auxi]) {
 							// Knob CV (adding, pre-scaling)
 							if (N_GRP == 4) {
 								val += inputs[inputNum].getVoltage(trk) * 0.1f * maxAGIndivSendFader;
@@ -648,23 +715,34 @@ struct AuxExpander : Module {
 							val = clamp(val, 0.0f, maxAGIndivSendFader);
 							indivTrackSendWithCv[(trk << 2) + auxi] = val;// can put here since unused when cv disconnected
 						}
-						trackSendVcaGains[trk][auxi] = val;
+						trackSendVcaGains[auxi] = val;
 					}
-					trackSendVcaGains[trk] = simd::pow<simd::float_4>(trackSendVcaGains[trk], GlobalConst::individualAuxSendScalingExponent);
-					trackSendVcaGains[trk] *= globalSends * simd::float_4(sendMuteSlewers[trk >> 2].out[trk & 0x3]);
+					trackSendVcaGains = simd::pow<simd::float_4>(trackSendVcaGains, GlobalConst::individualAuxSendScalingExponent);
+					trackSendVcaGains *= globalSends * simd::float_4(sendMuteSlewers[trk >> 2].out[trk & 0x3]);
+					sendBank.setGains(trk, trackSendVcaGains);
 				}
-				// vca the aux send knobs with the track's sound
-				auxSends[0] += trackSendVcaGains[trk] * simd::float_4(auxSendsTrkGrp[(trk << 1) + 0]);// L
-				auxSends[1] += trackSendVcaGains[trk] * simd::float_4(auxSendsTrkGrp[(trk << 1) + 1]);// R				
 			}
-			// accumulate groups
-			for (int grp = 0; grp < N_GRP; grp++) {
-				// prepare groupSendVcaGains when needed
-				if (ecoMode == 0 || (refreshCounter20 & 0x3) == 2) {// stagger 2
-					indivGroupSendCvConnected = inputs[POLY_GRPS_AD_CV_INPUT].isConnected();
-					for (int auxi = 0; auxi < 4; auxi++) {
+			// prepare the group send gains when needed
+			if ((refreshCounter20 & ecoMask) == (2 & ecoMask)) {// stagger 2
+				bool cvConnected = inputs[POLY_GRPS_AD_CV_INPUT].isConnected();
+				if (cvConnected != indivGroupSendCvConnected) {
+					sendGainsDirty |= ((1 << N_GRP) - 1) << N_TRK;// an unplugged cv must not be left in the gains
+				}
+				indivGroupSendCvConnected = cvConnected;
+				for (int grp = 0; grp < N_GRP; grp++) {
 					// 16 (8) individual group aux send knobs
-						float val = params[GROUP_AUXSEND_PARAMS + (grp << 2) + auxi].getValue();
+					simd::float_4 sendKnobs;
+					for (int auxi = 0; auxi < 4; auxi++) {
+						sendKnobs[auxi] = params[GROUP_AUXSEND_PARAMS + (grp << 2) + auxi].getValue();
+					}
+					if (!indivGroupSendCvConnected && (sendGainsDirty & (1 << (N_TRK + grp))) == 0 && movemask(sendKnobs == sendKnobsOld[N_TRK + grp]) == 0xF) {
+						continue;
+					}
+					sendKnobsOld[N_TRK + grp] = sendKnobs;
+					sendGainsDirty &= ~(1 << (N_TRK + grp));
+					simd::float_4 groupSendVcaGains;
+					for (int auxi = 0; auxi < 4; auxi++) {
+						float val = sendKnobs[auxi];
 						if (indivGroupSendCvConnected) {
 							// Knob CV (adding, pre-scaling)
 							int cvIndex = ((auxi << (N_GRP / 2)) + grp);// not the same order for the CVs
@@ -673,19 +751,21 @@ struct AuxExpander : Module {
 							indivGroupSendWithCv[(grp << 2) + auxi] = val;// can put here since unused when cv disconnected
 						}
 						if ((muteAuxSendWhenReturnGrouped & (1 << ((grp << 2) + auxi))) == 0) {
-							groupSendVcaGains[grp][auxi] = val;
+							groupSendVcaGains[auxi] = val;
 						}
 						else {
-							groupSendVcaGains[grp][auxi] = 0.0f;
+							groupSendVcaGains[auxi] = 0.0f;
 						}
 					}
-					groupSendVcaGains[grp] = simd::pow<simd::float_4>(groupSendVcaGains[grp], GlobalConst::individualAuxSendScalingExponent);
-					groupSendVcaGains[grp] *= globalSends * simd::float_4(sendMuteSlewers[N_TRK >> 2].out[grp]);
+					groupSendVcaGains = simd::pow<simd::float_4>(groupSendVcaGains, GlobalConst::individualAuxSendScalingExponent);
+					groupSendVcaGains *= globalSends * simd::float_4(sendMuteSlewers[N_TRK >> 2].out[grp]);
+					sendBank.setGains(N_TRK + grp, groupSendVcaGains);
 				}
-				// vca the aux send knobs with the group's sound
-				auxSends[0] += groupSendVcaGains[grp] * simd::float_4(auxSendsTrkGrp[(grp << 1) + N_TRK * 2 + 0]);// L
-				auxSends[1] += groupSendVcaGains[grp] * simd::float_4(auxSendsTrkGrp[(grp << 1) + N_TRK * 2 + 1]);// R				
-			}			
+			}
+			// vca the sounds of all tracks and groups with their aux send gains
+			// fastFromMother->auxSends has the 40 (20) values of the sends (Trk1L, Trk1R, Trk2L, Trk2R ... Trk16L, Trk16R, Grp1L, Grp1R ... Grp4L, Grp4R)
+			simd::float_4 auxSends[2];// [0] = ABCD left, [1] = ABCD right
+			sendBank.process(auxSends, fastFromMother->auxSends);
 			// Aux send outputs
 			for (int i = 0; i < 4; i++) {
 				if (outputs[SEND_OUTPUTS + i + 4].isConnected()) {
@@ -707,24 +787,32 @@ struct AuxExpander : Module {
 			// ***********
 			
 			MfaExpInterface *messagesToMother = static_cast<MfaExpInterface*>(leftExpander.module->rightExpander.producerMessage);
+			if (!motherWasPresent) {
+				messagesToMother->slowResync = true;
+			}
 			
-			messagesToMother->updateSlow = refresh.refreshCounter == 0;
-			if (messagesToMother->updateSlow) {
-				messagesToMother->directOutsModeLocalAux.cc1 = directOutsModeLocal.cc1;
-				messagesToMother->stereoPanModeLocalAux.cc1 = panLawStereoLocal.cc1;				
-				messagesToMother->auxVuColors.cc1 = vuColorThemeLocal.cc1;
-				messagesToMother->auxDispColors.cc1 = dispColorAuxLocal.cc1;
+			// Slow (only sent when changed)
+			if (refresh.refreshCounter == 0) {
+				MfaExpSlow *slowToMother = &messagesToMother->slowToWrite;
+				slowToMother->directOutsModeLocalAux.cc1 = directOutsModeLocal.cc1;
+				slowToMother->stereoPanModeLocalAux.cc1 = panLawStereoLocal.cc1;				
+				slowToMother->auxVuColors.cc1 = vuColorThemeLocal.cc1;
+				slowToMother->auxDispColors.cc1 = dispColorAuxLocal.cc1;
 				for (int i = 0; i < 12; i++) {// Aux mute, solo, group
-					messagesToMother->values20[i] = params[GLOBAL_AUXMUTE_PARAMS + i].getValue();
+					slowToMother->values20[i] = params[GLOBAL_AUXMUTE_PARAMS + i].getValue();
 				}
-				memcpy(&messagesToMother->values20[12], auxFadeRatesAndProfiles, 4 * 8);
-				memcpy(messagesToMother->auxLabels, &auxLabels, 4 * 4);
+				memcpy(&slowToMother->values20[12], auxFadeRatesAndProfiles, 4 * 8);
+				memcpy(slowToMother->auxLabels, &auxLabels, 4 * 4);
+				messagesToMother->publishSlow(args.frame, false);
 			}
 			
+			// Fast (written in place, no flip)
+			MfaExpFast *fastToMother = messagesToMother->fastToWrite(args.frame);
+			
 			// Aux returns
 			// left A, right A, left B, right B, left C, right C, left D, right D
 			for (int i = 0; i < 4; i++) {
-				aux[i].process(&messagesToMother->auxReturns[i << 1]);
+				aux[i].process(&fastToMother->auxReturns[i << 1]);
 			}
 						
 			// aux return pan
@@ -737,7 +825,7 @@ struct AuxExpander : Module {
 					val = clamp(val, 0.0f, 1.0f);
 					globalRetPansWithCV[i] = val;// can put here since unused when cv disconnected
 				}
-				messagesToMother->auxRetFaderPanFadercv[4 + i] = val;
+				fastToMother->auxRetFaderPanFadercv[4 + i] = val;
 			}
 			
 			// aux return fader
@@ -759,17 +847,17 @@ struct AuxExpander : Module {
 					paramRetFaderWithCv[i] = -100.0f;// do not show cv pointer
 				}
 
-				fader = std::pow(fader, GlobalConst::globalAuxReturnScalingExponent);// scaling
-				messagesToMother->auxRetFaderPanFadercv[i] = fader;
-				messagesToMother->auxRetFaderPanFadercv[8 + i] = volCv;// send back to mother in case linearVolCvInputs!=0
+				fader = powInt(fader, GlobalConst::globalAuxReturnScalingExponent);// scaling
+				fastToMother->auxRetFaderPanFadercv[i] = fader;
+				fastToMother->auxRetFaderPanFadercv[8 + i] = volCv;// send back to mother in case linearVolCvInputs!=0
 			}
+			
+			fastToMother->ecoCostNs = ecoMeter.costNs;
 				
 			refreshCounter20++;
 			if (refreshCounter20 >= 20) {
 				refreshCounter20 = 0;
 			}
-			
-			leftExpander.module->rightExpander.messageFlipRequested = true;
 		}	
 		else {// if (motherPresent)
 			for (int i = 0; i < N_TRK; i++) {
@@ -788,6 +876,9 @@ struct AuxExpander : Module {
 			}
 		}
 		
+		if (ecoMeterTimed) {
+			ecoMeter.end(ecoMeterCounter);
+		}
 		refresh.processLights(); // none, but this advances the refresh counter
 	}// process()
 
@@ -128,6 +128,30 @@ struct AuxspanderAux {
 		// extern must call resetNonJson()
 	}	
 
+
+	void dataToBlob(SettingsBlob* blob) {// same fields as dataToJson()
+		blob->beginRecord();
+		blob->put(getHPFCutoffFreq());
+		blob->put(getLPFCutoffFreq());
+		blob->put(stereoWidth);
+		blob->endRecord();
+	}
+
+
+	void dataFromBlob(SettingsBlob* blob) {
+		if (blob->openRecord()) {
+			float hpfCutoffFreqBlob = getHPFCutoffFreq();
+			float lpfCutoffFreqBlob = getLPFCutoffFreq();
+			blob->get(&hpfCutoffFreqBlob);
+			blob->get(&lpfCutoffFreqBlob);
+			blob->get(&stereoWidth);
+			setHPFCutoffFreq(hpfCutoffFreqBlob);
+			setLPFCutoffFreq(lpfCutoffFreqBlob);
+		}
+		blob->closeRecord();
+		// extern must call resetNonJson()
+	}	
+
 	void setHPFCutoffFreq(float fc) {// always use this instead of directly accessing hpfCutoffFreq
 		hpfCutoffFreq = fc;
 		fc *= APP->engine->getSampleTime();// fc is in normalized freq for rest of method
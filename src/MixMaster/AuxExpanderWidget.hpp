@@ -184,14 +184,15 @@ struct MismatchedAuxOverlay : widget::Widget {
 		Widget::drawLayer(args, layer);
 		if (layer == 1 && module != NULL) {
 			bool badMother = (module->leftExpander.module && module->leftExpander.module->model == (N_TRK == 16 ? modelMixMasterJr : modelMixMaster));
-			if (badMother) {
+			bool bigMother = (module->leftExpander.module && module->leftExpander.module->model == modelMixMaster32);// no aux pairing beyond 16 tracks
+			if (badMother || bigMother) {
 				nvgBeginPath(args.vg);
 				nvgRect(args.vg, 0 + margin, 0 + margin, box.size.x - 2 * margin, box.size.y - 2 * margin);
 				nvgFillColor(args.vg, nvgRGBAf(0, 0, 0, 0.6));
 				nvgFill(args.vg);
 
 				std::string text = "Mixer - AuxSpander mismatch";
-				std::string text2 = N_TRK == 16 ? "Please use the 8-track AuxSpander Jr" : "Please use the 16-track AuxSpander";
+				std::string text2 = bigMother ? "AuxSpander pairs with MixMaster and MixMaster Jr only" : (N_TRK == 16 ? "Please use the 8-track AuxSpander Jr" : "Please use the 16-track AuxSpander");
 				float ofx = bndLabelWidth(args.vg, -1, text.c_str()) + 2;
 				float ofy = bndLabelHeight(args.vg, -1, text.c_str(), ofx);
 				Rect r;
@@ -0,0 +1,64 @@
+//***********************************************************************************************
+//Mixer module for VCV Rack by Steve Baker and Marc Boulé
+//
+//Based on code from the Fundamental plugin by Andrew Belt
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+
+// Aux sends of all the tracks and groups of the mother, as one matrix-vector product.
+// The send gains are kept transposed: one row per aux, with the gain of each track and group twice (for its L and R),
+// so that a row lines up with the interleaved sends from the mother (Trk1L, Trk1R, Trk2L, Trk2R ... Grp1L, Grp1R ...).
+// The sends are then multiplied four floats at a time as they come, and all four auxes are done in the same pass
+// over the sends; the L R L R sums of each aux are reduced at the end.
+struct AuxSendBank {
+	static const int N_SRC = N_TRK + N_GRP;// tracks then groups
+	static const int N_QUAD = N_SRC / 2;// two stereo sources per quad
+	static_assert(N_SRC % 2 == 0, "AuxSendBank needs an even number of tracks and groups");
+
+	// Constants
+	// none
+
+	// need to save, no reset
+	// none
+
+	// need to save, with reset
+	// none
+
+	// no need to save, with reset
+	// none
+
+	// no need to save, no reset
+	alignas(16) float gains[4][N_SRC * 2];// [aux][src * 2 + 0] is for L, [aux][src * 2 + 1] is for R (same gain)
+
+
+	AuxSendBank() {
+		for (int src = 0; src < N_SRC; src++) {
+			setGains(src, simd::float_4::zero());
+		}
+	}
+
+
+	void setGains(int src, simd::float_4 srcGains) {// srcGains is ABCD
+		for (int auxi = 0; auxi < 4; auxi++) {
+			gains[auxi][(src << 1) + 0] = srcGains[auxi];
+			gains[auxi][(src << 1) + 1] = srcGains[auxi];
+		}
+	}
+
+
+	// auxSends[0] receives the ABCD left sends, auxSends[1] the ABCD right sends
+	void process(simd::float_4* auxSends, const float* sends) {
+		simd::float_4 acc[4] = {simd::float_4::zero(), simd::float_4::zero(), simd::float_4::zero(), simd::float_4::zero()};// L R L R for each aux
+		for (int q = 0; q < N_QUAD; q++) {
+			simd::float_4 in = simd::float_4::load(&sends[q << 2]);
+			for (int auxi = 0; auxi < 4; auxi++) {
+				acc[auxi] += simd::float_4::load(&gains[auxi][q << 2]) * in;
+			}
+		}
+		// after the transpose, acc[0] and acc[2] hold the left sums of ABCD, acc[1] and acc[3] the right sums
+		_MM_TRANSPOSE4_PS(acc[0].v, acc[1].v, acc[2].v, acc[3].v);
+		auxSends[0] = acc[0] + acc[2];
+		auxSends[1] = acc[1] + acc[3];
+	}
+};// struct AuxSendBank
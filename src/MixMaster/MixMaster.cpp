@@ -12,6 +12,9 @@
 
 template<int N_TRK, int N_GRP>
 struct MixMaster : Module {
+	// tracks come in groups of 8 in the poly insert and direct outs, tracks have one 64 bit word in the link, solo and slow dirty masks (see TrkGrpBits),
+	// and groups and aux share one 16 channel poly cable in the group/aux insert and direct outs
+	static_assert(N_TRK % 8 == 0 && N_TRK <= 64 && N_GRP <= 4, "unsupported number of tracks or groups");
 
 	enum ParamIds {
 		ENUMS(TRACK_FADER_PARAMS, N_TRK),
@@ -43,7 +46,7 @@ struct MixMaster : Module {
 		ENUMS(CHAIN_INPUTS, 2),
 		ENUMS(INSERT_TRACK_INPUTS, N_TRK / 8),
 		INSERT_GRP_AUX_INPUT,
-		ENUMS(TRACK_MUTESOLO_INPUTS, 2),
+		ENUMS(TRACK_MUTESOLO_INPUTS, N_TRK <= 16 ? 2 : N_TRK / 8),// all mutes then all solos, 16 per poly cable (8 trk mixer uses only the first cable)
 		GRPM_MUTESOLO_INPUT,// 1-4 Group mutes, 5-8 Group solos, 9 Master Mute, 10 Master Dim, 11 Master Mono, 12 Master VOL
 		NUM_INPUTS
 	};
@@ -53,7 +56,7 @@ struct MixMaster : Module {
 		ENUMS(MAIN_OUTPUTS, 2),
 		ENUMS(INSERT_TRACK_OUTPUTS, N_TRK / 8),
 		INSERT_GRP_AUX_OUTPUT,
-		FADE_CV_OUTPUT,
+		ENUMS(FADE_CV_OUTPUT, N_TRK <= 16 ? 1 : N_TRK / 16),
 		NUM_OUTPUTS
 	};
 
@@ -66,13 +69,17 @@ struct MixMaster : Module {
 	};
 
 	typedef TAfmExpInterface<N_TRK, N_GRP> AfmExpInterface;
+	typedef TAfmExpFast<N_TRK, N_GRP> AfmExpFast;
+	typedef TAfmExpSlow<N_TRK, N_GRP> AfmExpSlow;
 
 
+	#include "MixerFilterBank.hpp"
 	#include "MixMaster.hpp"
+	#include "MixerTrackBank.hpp"
 	
 	
 	// Expander
-	MfaExpInterface rightMessages[2];// messages from aux-expander, see MixerCommon.hpp
+	MfaExpInterface rightMessages;// messages from aux-expander, written in place by the expander, see MixerCommon.hpp
 
 	// Constants
 	const int numChannels16 = 16;// avoids warning that happens when hardcode 16 (static const or directly use 16 in code below)
@@ -83,7 +90,9 @@ struct MixMaster : Module {
 	// Need to save, with reset
 	alignas(4) char trackLabels[4 * (N_TRK + N_GRP) + 4];// 4 chars per label, 16 (8) tracks and 4 (2) groups means 20 (10) labels, null terminate the end the whole array only, pad with three extra chars for alignment
 	GlobalInfo* gInfo;
+	MixerFilterBank* filterBank;
 	std::vector<MixerTrack> tracks;// size N_TRK
+	MixerTrackBank* trackBank;
 	std::vector<MixerGroup> groups;// size N_GRP
 	std::vector<MixerAux> aux;// size 4
 	MixerMaster* master;
@@ -91,13 +100,26 @@ struct MixMaster : Module {
 	// No need to save, with reset
 	int updateTrackLabelRequest;// 0 when nothing to do, 1 for read names in widget
 	int refreshCounter4;
+	int slowSweepStrip;// next strip checked by sweepSlowChanged(): tracks, groups then master
 	int32_t trackMoveInAuxRequest;// 0 when nothing to do, {dest,src} packed when a move is requested
 	int8_t trackOrGroupResetInAux;// -1 when nothing to do, 0 to N_TRK-1 for track reset, N_TRK to N_TRK+N_GRP-1 for group reset 
 	SlewLimiterSingle muteTrackWhenSoloAuxRetSlewer;
+	// direct outs, gathered two strips per float_4 (refreshed with the inputs, see updateDirectOutTaps())
+	int directTrackTapOffsets[N_TRK];// offset of the chosen tap of each track in trackTaps
+	int directGroupTapOffsets[N_GRP];// offset of the chosen tap of each group in groupTaps
+	int directAuxTapOffsets[4];// offset of the chosen tap of each aux in auxTaps
+	simd::float_4 directTrackKeepMasks[N_TRK / 2];// L R L R of two tracks, lanes cleared when silenced (grouped track skipped, right of a mono track pre-fader)
+	simd::float_4 directTrackSoloMasks[N_TRK / 2];// lanes set when scaled by muteTrackWhenSoloAuxRetSlewer
+	simd::float_4 directGroupSoloMasks[N_GRP / 2];// same for groups
 
 	// No need to save, no reset
 	RefreshCounter refresh;	
 	bool auxExpanderPresent = false;// can't be local to process() since widget must know in order to properly draw border
+	EcoMeter ecoMeter;// when gInfo->ecoAdaptive != 0
+	float expanderEcoCostNs = 0.0f;
+	#ifdef MM_PROFILE
+	StageProfiler profiler;
+	#endif
 	float trackTaps[N_TRK * 2 * 4];// room for 4 taps for each of the 16 (8) stereo tracks. Trk0-tap0, Trk1-tap0 ... Trk15-tap0,  Trk0-tap1
 	float trackInsertOuts[N_TRK * 2];// room for 16 (8) stereo track insert outs
 	float groupTaps[N_GRP * 2 * 4];// room for 4 taps for each of the 4 stereo groups
@@ -119,39 +141,50 @@ struct MixMaster : Module {
 
 		
 	void sendToMessageBus(bool doTrackMoveInit) { 
-		int8_t vuColors[1 + 16 + 4 + 4];// room for global, tracks, groups, aux
-		int8_t dispColors[1 + 16 + 4 + 4];// room for global, tracks, groups, aux
-		vuColors[0] = gInfo->colorAndCloak.cc4[vuColorGlobal];
-		dispColors[0] = gInfo->colorAndCloak.cc4[dispColorGlobal];
-		if (vuColors[0] >= numVuThemes) {
-			for (int t = 0; t < N_TRK; t++) {
-				vuColors[1 + t] = tracks[t].vuColorThemeLocal;
-			}
-			for (int g = 0; g < N_GRP; g++) {
-				vuColors[1 + 16 + g] = groups[g].vuColorThemeLocal;
+		// the message bus has room for 16 tracks, so more tracks are sent as pages of 16 tracks (each a member of the bus), with the groups and aux in all of them
+		static const int numPages = (N_TRK + 15) / 16;
+		for (int page = 0; page < numPages; page++) {
+			int trk0 = page * 16;
+			int8_t vuColors[1 + 16 + 4 + 4];// room for global, tracks, groups, aux
+			int8_t dispColors[1 + 16 + 4 + 4];// room for global, tracks, groups, aux
+			vuColors[0] = gInfo->colorAndCloak.cc4[vuColorGlobal];
+			dispColors[0] = gInfo->colorAndCloak.cc4[dispColorGlobal];
+			if (vuColors[0] >= numVuThemes) {
+				for (int t = 0; t < std::min(N_TRK, 16); t++) {
+					vuColors[1 + t] = tracks[trk0 + t].vuColorThemeLocal;
+				}
+				for (int g = 0; g < N_GRP; g++) {
+					vuColors[1 + 16 + g] = groups[g].vuColorThemeLocal;
+				}
+				for (int a = 0; a < 4; a++) {
+					vuColors[1 + 16 + 4 + a] = auxVuColors.cc4[a];
+				}
 			}
-			for (int a = 0; a < 4; a++) {
-				vuColors[1 + 16 + 4 + a] = auxVuColors.cc4[a];
+			if (dispColors[0] >= numDispThemes) {
+				for (int t = 0; t < std::min(N_TRK, 16); t++) {
+					dispColors[1 + t] = tracks[trk0 + t].dispColorLocal;
+				}
+				for (int g = 0; g < N_GRP; g++) {
+					dispColors[1 + 16 + g] = groups[g].dispColorLocal;
+				}
+				for (int a = 0; a < 4; a++) {
+					dispColors[1 + 16 + 4 + a] = auxDispColors.cc4[a];
+				}
 			}
-		}
-		if (dispColors[0] >= numDispThemes) {
-			for (int t = 0; t < N_TRK; t++) {
-				dispColors[1 + t] = tracks[t].dispColorLocal;
+			
+			if (N_TRK < 16) {
+				mixerMessageBus.sendJr(id + 1, master->masterLabel, trackLabels, &(trackLabels[N_TRK * 4]), auxLabels, vuColors, dispColors, doTrackMoveInit);
 			}
-			for (int g = 0; g < N_GRP; g++) {
-				dispColors[1 + 16 + g] = groups[g].dispColorLocal;
+			else if (N_TRK == 16) {
+				mixerMessageBus.send(id + 1, master->masterLabel, trackLabels, auxLabels, vuColors, dispColors, doTrackMoveInit);
 			}
-			for (int a = 0; a < 4; a++) {
-				dispColors[1 + 16 + 4 + a] = auxDispColors.cc4[a];
+			else {
+				char pageLabels[4 * (16 + 4)];// 16 tracks of the page then the groups, contiguous as in trackLabels of a 16 track mixer
+				memcpy(pageLabels, &trackLabels[4 * trk0], 4 * 16);
+				memcpy(&pageLabels[4 * 16], &trackLabels[4 * N_TRK], 4 * N_GRP);
+				mixerMessageBus.send(MixerMessageBus::pageKey(id + 1, page), master->masterLabel, pageLabels, auxLabels, vuColors, dispColors, doTrackMoveInit, page, numPages);
 			}
 		}
-		
-		if (N_TRK < 16) {
-			mixerMessageBus.sendJr(id + 1, master->masterLabel, trackLabels, &(trackLabels[N_TRK * 4]), auxLabels, vuColors, dispColors, doTrackMoveInit);
-		}
-		else {
-			mixerMessageBus.send(id + 1, master->masterLabel, trackLabels, auxLabels, vuColors, dispColors, doTrackMoveInit);
-		}
 	}
 	
 		
@@ -159,8 +192,8 @@ struct MixMaster : Module {
 	MixMaster() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);		
 		
-		rightExpander.producerMessage = &rightMessages[0];
-		rightExpander.consumerMessage = &rightMessages[1];
+		rightExpander.producerMessage = &rightMessages;
+		rightExpander.consumerMessage = &rightMessages;// same transport, never flipped
 
 		char strBuf[32];
 		// Track
@@ -232,24 +265,46 @@ struct MixMaster : Module {
 
 		gInfo = new GlobalInfo(&params[0], values20);
 		trackLabels[4 * (N_TRK + N_GRP)] = 0;
+		filterBank = new MixerFilterBank();
 		tracks.reserve(N_TRK);
 		for (int i = 0; i < N_TRK; i++) {
-			tracks.push_back(MixerTrack(i, gInfo, &inputs[0], &params[0], &(trackLabels[4 * i]), &trackTaps[i << 1], groupTaps, &trackInsertOuts[i << 1]));
+			tracks.push_back(MixerTrack(i, gInfo, &inputs[0], &params[0], &(trackLabels[4 * i]), &trackTaps[i << 1], groupTaps, &trackInsertOuts[i << 1], filterBank));
 		}
+		trackBank = new MixerTrackBank(&tracks[0], gInfo, filterBank, trackTaps);
 		groups.reserve(N_GRP);
 		for (int i = 0; i < N_GRP; i++) {
-			groups.push_back(MixerGroup(i, gInfo, &inputs[0], &params[0], &(trackLabels[4 * (N_TRK + i)]), &groupTaps[i << 1], &groupInsertOuts[i << 1]));
+			groups.push_back(MixerGroup(i, gInfo, &inputs[0], &params[0], &(trackLabels[4 * (N_TRK + i)]), &groupTaps[i << 1], &groupInsertOuts[i << 1], filterBank));
 		}
 		aux.reserve(4);
 		for (int i = 0; i < 4; i++) {
 			aux.push_back(MixerAux(i, gInfo, &inputs[0], values20, &auxTaps[i << 1], &stereoPanModeLocalAux.cc4[i]));
 		}
 		master = new MixerMaster(gInfo, &params[0], &inputs[0]);
+		// the filter knobs mark their strip for a slow update when they are turned
+		for (int i = 0; i < N_TRK; i++) {
+			static_cast<HPFCutoffParamQuantity*>(paramQuantities[TRACK_HPCUT_PARAMS + i])->slowDirtyRequest = gInfo->slowDirtyRequest(i);
+			static_cast<LPFCutoffParamQuantity*>(paramQuantities[TRACK_LPCUT_PARAMS + i])->slowDirtyRequest = gInfo->slowDirtyRequest(i);
+		}
+		for (int i = 0; i < N_GRP; i++) {
+			static_cast<HPFCutoffParamQuantity*>(paramQuantities[GROUP_HPCUT_PARAMS + i])->slowDirtyRequest = gInfo->slowDirtyRequest(N_TRK + i);
+			static_cast<LPFCutoffParamQuantity*>(paramQuantities[GROUP_LPCUT_PARAMS + i])->slowDirtyRequest = gInfo->slowDirtyRequest(N_TRK + i);
+		}
 		muteTrackWhenSoloAuxRetSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second 
 		onReset();
 
 		// sendToMessageBus(true);// register by just writing data; true means doTrackMoveInit
 	}
+	void onPortChange(const PortChangeEvent& e) override {
+		// input cables that slow values depend on: stereo of the tracks and chain of the master
+		if (e.type == Port::INPUT) {
+			if (e.portId >= TRACK_SIGNAL_INPUTS && e.portId < TRACK_SIGNAL_INPUTS + N_TRK * 2) {
+				gInfo->requestSlowDirty((e.portId - TRACK_SIGNAL_INPUTS) >> 1);
+			}
+			else if (e.portId >= CHAIN_INPUTS && e.portId < CHAIN_INPUTS + 2) {
+				gInfo->requestSlowDirty(GlobalInfo::SLOW_MASTER);
+			}
+		}
+	}
 	void onAdd(const AddEvent& e) override {
 		// id only assigned when module has been added to the engine, so can't register switcher in module's constructor, must do it here:
 		sendToMessageBus(true);// register by just writing data; true means doTrackMoveInit
@@ -258,9 +313,13 @@ struct MixMaster : Module {
   
 	~MixMaster() {
 		delete gInfo;
+		delete trackBank;
+		delete filterBank;
 		delete master;
 		if (id > -1) {
-			mixerMessageBus.deregisterMember(id + 1);
+			for (int page = 0; page < (N_TRK + 15) / 16; page++) {
+				mixerMessageBus.deregisterMember(MixerMessageBus::pageKey(id + 1, page));
+			}
 		}
 	}
 
@@ -270,6 +329,7 @@ struct MixMaster : Module {
 		for (int i = 0; i < N_TRK; i++) {
 			tracks[i].onReset();
 		}
+		trackBank->onReset();
 		for (int i = 0; i < N_GRP; i++) {
 			groups[i].onReset();
 		}
@@ -282,6 +342,7 @@ struct MixMaster : Module {
 	void resetNonJson(bool recurseNonJson) {
 		updateTrackLabelRequest = 1;
 		refreshCounter4 = 0;
+		slowSweepStrip = 0;
 		trackMoveInAuxRequest = 0;
 		trackOrGroupResetInAux = -1;
 		if (recurseNonJson) {
@@ -289,6 +350,7 @@ struct MixMaster : Module {
 			for (int i = 0; i < N_TRK; i++) {
 				tracks[i].resetNonJson();
 			}
+			trackBank->resetNonJson();
 			for (int i = 0; i < N_GRP; i++) {
 				groups[i].resetNonJson();
 			}
@@ -301,6 +363,7 @@ struct MixMaster : Module {
 			values20[i] = 0.0f;
 		}
 		muteTrackWhenSoloAuxRetSlewer.reset();
+		updateDirectOutTaps();
 	}
 
 
@@ -317,20 +380,38 @@ struct MixMaster : Module {
 		// gInfo
 		gInfo->dataToJson(rootJ);
 
-		// tracks
+		// strips (tracks, groups and master, the aux have nothing to save), in one blob
+		SettingsBlob blob;
+		blob.put(SettingsBlob::VERSION);
+		blob.put((int8_t)N_TRK);
+		blob.put((int8_t)N_GRP);
 		for (int i = 0; i < N_TRK; i++) {
-			tracks[i].dataToJson(rootJ);
+			tracks[i].dataToBlob(&blob);
 		}
-		// groups
 		for (int i = 0; i < N_GRP; i++) {
-			groups[i].dataToJson(rootJ);
+			groups[i].dataToBlob(&blob);
 		}
-		// aux
-		for (int i = 0; i < 4; i++) {
-			aux[i].dataToJson(rootJ);
+		master->dataToBlob(&blob);
+		json_object_set_new(rootJ, "stripsBlob", json_string(blob.toBase64().c_str()));
+		
+		// strips again in per-strip keys, only when asked for in the menu, so that plugin versions from before the blob can open 
+		// the patch; dataFromJson() still reads these keys when there is no blob, the writing and the option go in v3
+		if (isMmSaveLegacyStripKeys()) {
+			// tracks
+			for (int i = 0; i < N_TRK; i++) {
+				tracks[i].dataToJson(rootJ);
+			}
+			// groups
+			for (int i = 0; i < N_GRP; i++) {
+				groups[i].dataToJson(rootJ);
+			}
+			// aux
+			for (int i = 0; i < 4; i++) {
+				aux[i].dataToJson(rootJ);
+			}
+			// master
+			master->dataToJson(rootJ);
 		}
-		// master
-		master->dataToJson(rootJ);
 		
 		return rootJ;
 	}
@@ -351,23 +432,71 @@ struct MixMaster : Module {
 		// gInfo
 		gInfo->dataFromJson(rootJ, nTrkSrc, nGrpSrc);
 
-		// tracks
-		for (int i = 0; i < std::min(N_TRK, nTrkSrc); i++) {
-			tracks[i].dataFromJson(rootJ);
-		}
-		// groups
-		for (int i = 0; i < std::min(N_GRP, nGrpSrc); i++) {
-			groups[i].dataFromJson(rootJ);
-		}
-		// aux
-		for (int i = 0; i < 4; i++) {
-			aux[i].dataFromJson(rootJ);
+		// strips
+		if (!stripsFromBlob(rootJ)) {
+			// per-strip keys, as saved before the blob
+			// tracks
+			for (int i = 0; i < std::min(N_TRK, nTrkSrc); i++) {
+				tracks[i].dataFromJson(rootJ);
+			}
+			// groups
+			for (int i = 0; i < std::min(N_GRP, nGrpSrc); i++) {
+				groups[i].dataFromJson(rootJ);
+			}
+			// aux
+			for (int i = 0; i < 4; i++) {
+				aux[i].dataFromJson(rootJ);
+			}
+			// master
+			master->dataFromJson(rootJ);
 		}
-		// master
-		master->dataFromJson(rootJ);
 		
 		resetNonJson(true);
 	}
+	bool stripsFromBlob(json_t *rootJ) {// returns false when there is no blob or when it can't be read
+		json_t *blobJ = json_object_get(rootJ, "stripsBlob");
+		if (!blobJ) {
+			return false;
+		}
+		SettingsBlob blob;
+		if (!blob.fromBase64(json_string_value(blobJ))) {
+			WARN("MixMaster: error decoding stripsBlob");
+			return false;
+		}
+		uint8_t version = 0;
+		int8_t nTrkSrc = 0;
+		int8_t nGrpSrc = 0;
+		blob.get(&version);
+		blob.get(&nTrkSrc);
+		blob.get(&nGrpSrc);
+		if (blob.error || version != SettingsBlob::VERSION) {
+			WARN("MixMaster: error stripsBlob version %i not supported", (int)version);
+			return false;
+		}
+		if (!blob.checkRecords(nTrkSrc + nGrpSrc + 1)) {// nothing is loaded from a blob that is cut short, the keys are used instead
+			WARN("MixMaster: error stripsBlob truncated");
+			return false;
+		}
+		// the strips that both mixers have are loaded, the others are skipped
+		for (int i = 0; i < nTrkSrc; i++) {
+			if (i < N_TRK) {
+				tracks[i].dataFromBlob(&blob);
+			}
+			else if (blob.openRecord()) {
+				blob.closeRecord();
+			}
+		}
+		for (int i = 0; i < nGrpSrc; i++) {
+			if (i < N_GRP) {
+				groups[i].dataFromBlob(&blob);
+			}
+			else if (blob.openRecord()) {
+				blob.closeRecord();
+			}
+		}
+		master->dataFromBlob(&blob);
+		return true;
+	}
 	
 
 	void swapCopyToClipboard() {
@@ -513,7 +642,7 @@ struct MixMaster : Module {
 
 
 	void onSampleRateChange() override {
-		gInfo->sampleTime = APP->engine->getSampleTime();
+		gInfo->onSampleRateChange();
 		for (int trk = 0; trk < N_TRK; trk++) {
 			tracks[trk].onSampleRateChange();
 		}
@@ -525,65 +654,64 @@ struct MixMaster : Module {
 	
 
 	void process(const ProcessArgs &args) override {
+		uint16_t ecoMeterCounter = refresh.refreshCounter;
+		bool ecoMeterTimed = (gInfo->ecoAdaptive != 0 && ecoMeter.begin(ecoMeterCounter));
+		MM_PROF_START(profiler);
 		
-		auxExpanderPresent = (rightExpander.module && rightExpander.module->model == (N_TRK == 16 ? modelAuxExpander : modelAuxExpanderJr));
+		bool auxExpanderWasPresent = auxExpanderPresent;
+		auxExpanderPresent = (rightExpander.module && (N_TRK == 16 || N_TRK == 8) && rightExpander.module->model == (N_TRK == 16 ? modelAuxExpander : modelAuxExpanderJr));
 		
 		
 		//********** Inputs **********
 		
 		// From Aux-Expander
 		if (auxExpanderPresent) {
-			MfaExpInterface *messagesFromExpander = static_cast<MfaExpInterface*>(rightExpander.consumerMessage);// could be invalid pointer when !expanderPresent, so read it only when expanderPresent
-			
-			// Slow values from expander
-			if (messagesFromExpander->updateSlow) {
-				directOutsModeLocalAux.cc1 = messagesFromExpander->directOutsModeLocalAux.cc1;
-				stereoPanModeLocalAux.cc1 = messagesFromExpander->stereoPanModeLocalAux.cc1;
-				auxVuColors.cc1 = messagesFromExpander->auxVuColors.cc1;
-				auxDispColors.cc1 = messagesFromExpander->auxDispColors.cc1;
-				memcpy(values20, messagesFromExpander->values20, 4 * 20);
-				memcpy(auxLabels, messagesFromExpander->auxLabels, 4 * 4);
+			// Slow values from expander (only when they changed)
+			MfaExpSlow *slowFromExpander = rightMessages.slowToRead(args.frame);
+			if (slowFromExpander) {
+				directOutsModeLocalAux.cc1 = slowFromExpander->directOutsModeLocalAux.cc1;
+				stereoPanModeLocalAux.cc1 = slowFromExpander->stereoPanModeLocalAux.cc1;
+				auxVuColors.cc1 = slowFromExpander->auxVuColors.cc1;
+				auxDispColors.cc1 = slowFromExpander->auxDispColors.cc1;
+				memcpy(values20, slowFromExpander->values20, 4 * 20);
+				memcpy(auxLabels, slowFromExpander->auxLabels, 4 * 4);
+				gInfo->updateReturnSoloBits();
+				gInfo->slowDirty.grp |= GlobalInfo::SLOW_AUX_MASK;// return solos and stereo pan modes
+			}
+			if (!auxExpanderWasPresent) {
+				gInfo->slowDirty.grp |= GlobalInfo::SLOW_AUX_MASK;// the aux are skipped by updateDirtySlowValues() while there is no expander
 			}
 			
-			// Aux returns
-			auxReturns = messagesFromExpander->auxReturns; // contains 8 values of the returns from the aux panel
-			auxRetFadePanFadecv = messagesFromExpander->auxRetFaderPanFadercv; // contains 12 values of the return faders and pan knobs and cvs for faders			
+			// Aux returns (the expander is writing into the other slot, so these stay valid for this whole sample)
+			MfaExpFast *fastFromExpander = rightMessages.fastToRead(args.frame);
+			auxReturns = fastFromExpander->auxReturns; // contains 8 values of the returns from the aux panel
+			auxRetFadePanFadecv = fastFromExpander->auxRetFaderPanFadercv; // contains 12 values of the return faders and pan knobs and cvs for faders			
+			expanderEcoCostNs = fastFromExpander->ecoCostNs;
 		}
 		else {
 			muteTrackWhenSoloAuxRetSlewer.reset();
+			expanderEcoCostNs = 0.0f;
 		}
+		MM_PROF_LAP(profiler, PROF_EXP_READ);
 
+		// Slow values: only the strips marked in gInfo->slowDirty are updated, as soon as the next sample for what the ui thread marks
+		gInfo->takeSlowDirtyRequests();
 		if (refresh.processInputs()) {
-			int sixteenCount = refresh.refreshCounter >> 4;// Corresponds to 172Hz refreshing of each track, at 44.1 kHz
-			
-			// Tracks
-			int trackToProcess = (N_TRK == 16 ? sixteenCount : (sixteenCount & 0x7));
-			gInfo->updateSoloBit(trackToProcess);
-			tracks[trackToProcess].updateSlowValues();// a track is updated once every 16 passes in input proceesing
-			// Groups
-			if ( (sixteenCount & 0x3) == 0) {// a group is updated once every 16 passes in input proceesing
-				int groupToProcess = sixteenCount >> (4 - N_GRP / 2);
-				gInfo->updateSoloBit(N_TRK + groupToProcess);
-				groups[groupToProcess].updateSlowValues();
-			}
-			// Aux
-			if ( auxExpanderPresent && ((sixteenCount & 0x3) == 1) ) {// an aux is updated once every 16 passes in input proceesing
-				gInfo->updateReturnSoloBits();
-				aux[sixteenCount >> 2].updateSlowValues();
-			}
-			// Master
-			if ((sixteenCount & 0x3) == 2) {// master and groupUsage updated once every 4 passes in input proceesing
-				master->updateSlowValues();
-				gInfo->updateGroupUsage();
-			}
-			
 			processMuteSoloCvTriggers();
+			updateDirectOutTaps();
+			gInfo->updateSlowDirty();
+			sweepSlowChanged();
 		}// userInputs refresh
+		if (gInfo->slowDirty.any()) {
+			updateDirtySlowValues();
+		}
+		MM_PROF_LAP(profiler, PROF_SLOW);
 		
 		
-		// ecoCode: cycles from 0 to 3 in eco mode, stuck at 0 when full power mode
-		uint16_t ecoCode = (refresh.refreshCounter & 0x3 & gInfo->ecoMode);
-		bool ecoStagger4 = (gInfo->ecoMode == 0 || ecoCode == 3);
+		// ecoCode: cycles from 0 to the control-rate divider minus one in eco mode, stuck at 0 when full power mode
+		// the four staggers run at phases 0 to 3 of the cycle (folded onto phases 0 and 1 when the divider is 2, all at 0 when 1)
+		uint16_t ecoCode = (refresh.refreshCounter & gInfo->ecoMask);
+		bool ecoStagger4 = (ecoCode == (3 & gInfo->ecoMask));
 				
 	
 		//********** Outputs **********
@@ -597,13 +725,12 @@ struct MixMaster : Module {
 		// none
 		
 		// Tracks
-		for (int trk = 0; trk < N_TRK; trk++) {
-			tracks[trk].process(mix, ecoCode == 0);// stagger 1
-		}
+		trackBank->process(mix, groupTaps, ecoCode == 0);// stagger 1
+		MM_PROF_LAP(profiler, PROF_TRACKS);
 		// Aux return when group
 		if (auxExpanderPresent) {
 			muteAuxSendWhenReturnGrouped = 0;
-			bool ecoStagger3 = (gInfo->ecoMode == 0 || ecoCode == 2);
+			bool ecoStagger3 = (ecoCode == (2 & gInfo->ecoMask));
 			for (int auxi = 0; auxi < 4; auxi++) {
 				int auxGroup = aux[auxi].getAuxGroup();
 				if (auxGroup != 0) {
@@ -615,12 +742,23 @@ struct MixMaster : Module {
 				}
 			}
 		}
+		MM_PROF_LAP(profiler, PROF_GRP_AUX_RET);
 		
 		// Groups (at this point, all groups's tap0 are setup and ready)
-		bool ecoStagger2 = (gInfo->ecoMode == 0 || ecoCode == 1);
+		bool ecoStagger2 = (ecoCode == (1 & gInfo->ecoMask));
+		for (int i = 0; i < N_GRP; i++) {
+			groups[i].processPreInsert();
+		}
+		memcpy(&groupTaps[N_GRP * 2], &groupTaps[0], N_GRP * 2 * 4);
+		filterBank->process(&groupTaps[N_GRP * 2], MixerFilterBank::GRP_QUAD, N_GRP / 2, true);// filters pre-insert
+		for (int i = 0; i < N_GRP; i++) {
+			groups[i].processInserts();
+		}
+		filterBank->process(&groupTaps[N_GRP * 2], MixerFilterBank::GRP_QUAD, N_GRP / 2, false);// filters post-insert
 		for (int i = 0; i < N_GRP; i++) {
 			groups[i].process(mix, ecoStagger2);// stagger 2
 		}
+		MM_PROF_LAP(profiler, PROF_GROUPS);
 		
 		// Aux
 		if (auxExpanderPresent) {
@@ -633,31 +771,35 @@ struct MixMaster : Module {
 			mix[1] *= muteTrackWhenSoloAuxRetSlewer.out;
 			
 			// Aux returns when no group
-			bool ecoStagger3 = (gInfo->ecoMode == 0 || ecoCode == 2);
+			bool ecoStagger3 = (ecoCode == (2 & gInfo->ecoMask));
 			for (int auxi = 0; auxi < 4; auxi++) {
 				if (aux[auxi].getAuxGroup() == 0) {
 					aux[auxi].process(mix, &auxRetFadePanFadecv[auxi], ecoStagger3);// stagger 3
 				}
 			}
 		}
+		MM_PROF_LAP(profiler, PROF_AUX);
 		// Master
 		master->process(mix, ecoStagger4);// stagger 4
+		MM_PROF_LAP(profiler, PROF_MASTER);
+		
+		// VUs of all of the above
+		gInfo->vuBank.process(gInfo->sampleTime * (1 + gInfo->ecoMask));
+		MM_PROF_LAP(profiler, PROF_VUS);
 		
 		// Set master outputs
 		outputs[MAIN_OUTPUTS + 0].setVoltage(mix[0]);
 		outputs[MAIN_OUTPUTS + 1].setVoltage(mix[1]);
 		
 		// Direct outs (uses trackTaps, groupTaps and auxTaps)
-		SetDirectTrackOuts(0);// 1-8
-		if (N_TRK == 16) {
-			SetDirectTrackOuts(8);// 9-16
+		for (int base = 0; base < N_TRK; base += 8) {
+			SetDirectTrackOuts(base);// 1-8, 9-16, etc.
 		}
 		SetDirectGroupAuxOuts();
 				
 		// Insert outs (uses trackInsertOuts, groupInsertOuts and aux tap0)
-		SetInsertTrackOuts(0);// 1-8
-		if (N_TRK == 16) {
-			SetInsertTrackOuts(8);// 9-16
+		for (int base = 0; base < N_TRK; base += 8) {
+			SetInsertTrackOuts(base);// 1-8, 9-16, etc.
 		}
 		SetInsertGroupAuxOuts();	
 
@@ -669,7 +811,9 @@ struct MixMaster : Module {
 		
 		if (refresh.processLights()) {
 			// see module widget step()
+			gInfo->updateEcoMask(ecoMeter.costNs + expanderEcoCostNs, args.sampleTime);
 		}// processLights()
+		MM_PROF_LAP(profiler, PROF_OUTS);
 
 
 
@@ -678,19 +822,23 @@ struct MixMaster : Module {
 		// To Aux-Expander
 		if (auxExpanderPresent) {
 			AfmExpInterface *messageToExpander = static_cast<AfmExpInterface*>(rightExpander.module->leftExpander.producerMessage);
+			if (!auxExpanderWasPresent) {
+				messageToExpander->slowResync = true;
+			}
 			
-			// Slow
-			messageToExpander->updateSlow = refresh.refreshCounter == 0;
-			if (messageToExpander->updateSlow) {
-				messageToExpander->colorAndCloak.cc1 = gInfo->colorAndCloak.cc1;
-				messageToExpander->directOutPanStereoMomentCvLinearVol.cc1 = gInfo->directOutPanStereoMomentCvLinearVol.cc1;
-				messageToExpander->muteAuxSendWhenReturnGrouped = muteAuxSendWhenReturnGrouped;
-				messageToExpander->ecoMode = gInfo->ecoMode;
-				messageToExpander->trackMoveInAuxRequest = trackMoveInAuxRequest;
+			// Slow (only sent when changed)
+			if (refresh.refreshCounter == 0) {
+				AfmExpSlow *slowToExpander = &messageToExpander->slowToWrite;
+				bool oneShotRequest = (trackMoveInAuxRequest != 0 || trackOrGroupResetInAux != -1 || globalToLocalOp.opCodeExpander != GTOL_NOP);
+				slowToExpander->colorAndCloak.cc1 = gInfo->colorAndCloak.cc1;
+				slowToExpander->directOutPanStereoMomentCvLinearVol.cc1 = gInfo->directOutPanStereoMomentCvLinearVol.cc1;
+				slowToExpander->muteAuxSendWhenReturnGrouped = muteAuxSendWhenReturnGrouped;
+				slowToExpander->ecoMode = gInfo->ecoMask;
+				slowToExpander->trackMoveInAuxRequest = trackMoveInAuxRequest;
 				trackMoveInAuxRequest = 0;
-				messageToExpander->trackOrGroupResetInAux = trackOrGroupResetInAux;
+				slowToExpander->trackOrGroupResetInAux = trackOrGroupResetInAux;
 				trackOrGroupResetInAux = -1;
-				memcpy(messageToExpander->trackLabels, trackLabels, ((N_TRK + N_GRP) << 2));
+				memcpy(slowToExpander->trackLabels, trackLabels, ((N_TRK + N_GRP) << 2));
 				
 				if (gInfo->colorAndCloak.cc4[dispColorGlobal] >= numDispThemes) {
 					PackedBytes4 tmpDispCols[N_TRK / 4 + 1];
@@ -702,55 +850,62 @@ struct MixMaster : Module {
 					for (int j = 0; j < N_GRP; j++) {
 						tmpDispCols[N_TRK / 4].cc4[j] = groups[ j ].dispColorLocal;
 					}
-					memcpy(messageToExpander->trackDispColsLocal, tmpDispCols, (N_TRK / 4 + 1) * 4);
+					memcpy(slowToExpander->trackDispColsLocal, tmpDispCols, (N_TRK / 4 + 1) * 4);
 				}
 				
 				// auxFadeGains
 				for (int auxi = 0; auxi < 4; auxi++) {
-					messageToExpander->auxRetFadeGains[auxi] = aux[auxi].fadeGain;
+					slowToExpander->auxRetFadeGains[auxi] = aux[auxi].fadeGain;
 				}
 				// mute ghost
 				for (int auxi = 0; auxi < 4; auxi++) {
-					messageToExpander->srcMuteGhost[auxi] = aux[auxi].fadeGainScaledWithSolo;
+					slowToExpander->srcMuteGhost[auxi] = aux[auxi].fadeGainScaledWithSolo;
 				}
 				// GlobalToLocal operation
-				messageToExpander->globalToLocalOp.opCodeExpander = GTOL_NOP;
+				slowToExpander->globalToLocalOp.opCodeExpander = GTOL_NOP;
 				if (globalToLocalOp.opCodeExpander != GTOL_NOP) {
 					// only auxspander locals set here via expander, mixer locals are set in module widget's step()
-					messageToExpander->globalToLocalOp = globalToLocalOp;
+					slowToExpander->globalToLocalOp = globalToLocalOp;
 					globalToLocalOp.opCodeExpander = GTOL_NOP;
 				}
+				messageToExpander->publishSlow(args.frame, oneShotRequest);
 			}
 			
-			// Fast
+			// Fast (written in place, no flip)
+			AfmExpFast *fastToExpander = messageToExpander->fastToWrite(args.frame);
 			
 			// 16+4 (8+2) stereo signals to be used to make sends in aux expander
-			writeAuxSends(messageToExpander->auxSends);						
+			writeAuxSends(fastToExpander->auxSends);						
 			// Aux VUs
 			// a return VU related value; index 0-3 : quad vu floats of a given aux
-			messageToExpander->vuIndex = refreshCounter4;
-			memcpy(messageToExpander->vuValues, aux[refreshCounter4].vu.vuValues, 4 * 4);
+			fastToExpander->vuIndex = refreshCounter4;
+			memcpy(fastToExpander->vuValues, aux[refreshCounter4].vu.vuValues, 4 * 4);
 			
 			refreshCounter4++;
 			if (refreshCounter4 >= 4) {
 				refreshCounter4 = 0;
 			}
-			
-			rightExpander.module->leftExpander.messageFlipRequested = true;
 		}// if (auxExpanderPresent)
-
+		MM_PROF_LAP(profiler, PROF_EXP_WRITE);
+		
+		if (ecoMeterTimed) {
+			ecoMeter.end(ecoMeterCounter);
+		}
 	}// process()
 	
 	
 	void setFadeCvOuts() {
-		if (outputs[FADE_CV_OUTPUT].isConnected()) {
-			outputs[FADE_CV_OUTPUT].setChannels(N_TRK == 16 ? numChannels16 : 8);
-			for (int trk = 0; trk < N_TRK; trk++) {
-				float outV = tracks[trk].fadeGain * 10.0f;
-				if (gInfo->fadeCvOutsWithVolCv) {
-					outV *= tracks[trk].volCv;
+		for (int base = 0; base < N_TRK; base += 16) {// 16 tracks per poly cable
+			Output* fadeCvOut = &outputs[FADE_CV_OUTPUT + (base >> 4)];
+			if (fadeCvOut->isConnected()) {
+				fadeCvOut->setChannels(N_TRK >= 16 ? numChannels16 : 8);
+				for (int trk = base; trk < std::min(N_TRK, base + 16); trk++) {
+					float outV = tracks[trk].fadeGain * 10.0f;
+					if (gInfo->fadeCvOutsWithVolCv) {
+						outV *= tracks[trk].volCv;
+					}
+					fadeCvOut->setVoltage(outV, trk - base);
 				}
-				outputs[FADE_CV_OUTPUT].setVoltage(outV, trk);
 			}
 		}
 	}
@@ -764,12 +919,12 @@ struct MixMaster : Module {
 		
 		// tracks
 		if ( gInfo->auxSendsMode < 4 && gInfo->masterFaderScalesSends == 0 && (gInfo->groupsControlTrackSendLevels == 0 || gInfo->groupUsage[N_GRP] == 0) ) {
-			memcpy(auxSends, &trackTaps[gInfo->auxSendsMode << (3 + N_TRK / 8)], (N_TRK * 2) * 4);
+			memcpy(auxSends, &trackTaps[gInfo->auxSendsMode * N_TRK * 2], (N_TRK * 2) * 4);
 		}
 		else {			
 			for (int trk = 0; trk < N_TRK; trk++) {
 				// tracks should have aux sends even when grouped
-				int tapIndex = (tracks[trk].auxSendsMode << (3 + N_TRK / 8));
+				int tapIndex = tracks[trk].auxSendsMode * N_TRK * 2;
 				float trackL = trackTaps[tapIndex + (trk << 1) + 0];
 				float trackR = trackTaps[tapIndex + (trk << 1) + 1];
 				int trkGroup;
@@ -806,87 +961,91 @@ struct MixMaster : Module {
 	}
 	
 	
-	void SetDirectTrackOuts(const int base) {// base is 0 or 8
-		int outi = base >> 3;
-		if (outputs[DIRECT_OUTPUTS + outi].isConnected()) {
-			outputs[DIRECT_OUTPUTS + outi].setChannels(numChannels16);
-
-			for (unsigned int i = 0; i < 8; i++) {
-				if (gInfo->directOutsSkipGroupedTracks != 0 && tracks[base + i].paGroup->getValue() >= 0.5f) {
-					outputs[DIRECT_OUTPUTS + outi].setVoltage(0.0f, 2 * i);
-					outputs[DIRECT_OUTPUTS + outi].setVoltage(0.0f, 2 * i + 1);
-				}
-				else {
-					int tapIndex = gInfo->directOutPanStereoMomentCvLinearVol.cc4[0] < 4 ? gInfo->directOutPanStereoMomentCvLinearVol.cc4[0] : tracks[base + i].directOutsMode;
-					int offset = (tapIndex << (3 + N_TRK / 8)) + ((base + i) << 1);
-					float leftSig = trackTaps[offset + 0];
-					float rightSig = (tapIndex < 2 && !inputs[((base + i) << 1) + 1].isConnected()) ? 0.0f : trackTaps[offset + 1];
-					if (auxExpanderPresent && gInfo->auxReturnsSolosMuteDry != 0 && tapIndex == 3) {
-						leftSig *= muteTrackWhenSoloAuxRetSlewer.out;
-						rightSig *= muteTrackWhenSoloAuxRetSlewer.out;
-					}
-					outputs[DIRECT_OUTPUTS + outi].setVoltage(leftSig, 2 * i);
-					outputs[DIRECT_OUTPUTS + outi].setVoltage(rightSig, 2 * i + 1);
-				}
+	// tap choices of the direct outs: the global one, or the local one of each strip when global is 4
+	void updateDirectOutTaps() {
+		int globalTap = gInfo->directOutPanStereoMomentCvLinearVol.cc4[0];
+		bool soloMutesDry = (auxExpanderPresent && gInfo->auxReturnsSolosMuteDry != 0);
+		
+		// Tracks
+		for (int trk = 0; trk < N_TRK; trk += 2) {
+			float keep[4];
+			float solo[4];
+			for (int j = 0; j < 2; j++) {
+				int tapIndex = globalTap < 4 ? globalTap : tracks[trk + j].directOutsMode;
+				directTrackTapOffsets[trk + j] = tapIndex * N_TRK * 2 + ((trk + j) << 1);
+				bool skipped = (gInfo->directOutsSkipGroupedTracks != 0 && tracks[trk + j].paGroup->getValue() >= 0.5f);
+				keep[(j << 1) + 0] = skipped ? 0.0f : 1.0f;
+				keep[(j << 1) + 1] = (skipped || (tapIndex < 2 && !inputs[((trk + j) << 1) + 1].isConnected())) ? 0.0f : 1.0f;
+				solo[(j << 1) + 0] = solo[(j << 1) + 1] = (soloMutesDry && tapIndex == 3) ? 1.0f : 0.0f;
+			}
+			directTrackKeepMasks[trk >> 1] = simd::float_4::load(keep) != 0.0f;
+			directTrackSoloMasks[trk >> 1] = simd::float_4::load(solo) != 0.0f;
+		}
+		
+		// Groups
+		for (int grp = 0; grp < N_GRP; grp += 2) {
+			float solo[4];
+			for (int j = 0; j < 2; j++) {
+				int tapIndex = globalTap < 4 ? globalTap : groups[grp + j].directOutsMode;
+				directGroupTapOffsets[grp + j] = tapIndex * N_GRP * 2 + ((grp + j) << 1);
+				solo[(j << 1) + 0] = solo[(j << 1) + 1] = (soloMutesDry && tapIndex == 3) ? 1.0f : 0.0f;
+			}
+			directGroupSoloMasks[grp >> 1] = simd::float_4::load(solo) != 0.0f;
+		}
+		
+		// Aux (same signal flow as a group, no solo muting)
+		for (int auxi = 0; auxi < 4; auxi++) {
+			int tapIndex = globalTap < 4 ? globalTap : directOutsModeLocalAux.cc4[auxi];
+			directAuxTapOffsets[auxi] = (tapIndex << 3) + (auxi << 1);
+		}
+	}
+	
+	
+	static inline simd::float_4 gatherTwoStereo(const float* taps, const int* offsets) {
+		const float* tap0 = &taps[offsets[0]];
+		const float* tap1 = &taps[offsets[1]];
+		return simd::float_4(tap0[0], tap0[1], tap1[0], tap1[1]);
+	}
+	
+	
+	void SetDirectTrackOuts(const int base) {// base is 0, 8, etc.
+		Output* directOut = &outputs[DIRECT_OUTPUTS + (base >> 3)];
+		if (directOut->isConnected()) {
+			directOut->setChannels(numChannels16);
+			float soloGain = muteTrackWhenSoloAuxRetSlewer.out;
+			for (int i = 0; i < 8; i += 2) {
+				int trk = base + i;
+				simd::float_4 sig = gatherTwoStereo(trackTaps, &directTrackTapOffsets[trk]);
+				sig = simd::ifelse(directTrackSoloMasks[trk >> 1], sig * soloGain, sig);
+				directOut->setVoltageSimd(simd::ifelse(directTrackKeepMasks[trk >> 1], sig, 0.0f), i << 1);
 			}
 		}
 	}
 	
 	void SetDirectGroupAuxOuts() {
-		int outputNum = DIRECT_OUTPUTS + N_TRK / 8;
-		if (outputs[outputNum].isConnected()) {
-			outputs[outputNum].setChannels(auxExpanderPresent ? numChannels16 : 8);
+		Output* directOut = &outputs[DIRECT_OUTPUTS + N_TRK / 8];
+		if (directOut->isConnected()) {
+			directOut->setChannels(auxExpanderPresent ? numChannels16 : 8);
 
 			// Groups
-			int tapIndex = gInfo->directOutPanStereoMomentCvLinearVol.cc4[0];			
-			if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[0] < 4) {// global direct outs
-				if (auxExpanderPresent && gInfo->auxReturnsSolosMuteDry != 0 && tapIndex == 3) {
-					for (unsigned int i = 0; i < N_GRP; i++) {
-						int offset = (tapIndex << (1 + N_GRP / 2)) + (i << 1);
-						outputs[outputNum].setVoltage(groupTaps[offset + 0] * muteTrackWhenSoloAuxRetSlewer.out, 2 * i);
-						outputs[outputNum].setVoltage(groupTaps[offset + 1] * muteTrackWhenSoloAuxRetSlewer.out, 2 * i + 1);
-					}
-				}
-				else {
-					memcpy(outputs[outputNum].getVoltages(), &groupTaps[(tapIndex << (1 + N_GRP / 2))], 4 * N_GRP * 2);
-				}
-			}
-			else {// per group direct outs
-				for (unsigned int i = 0; i < N_GRP; i++) {
-					tapIndex = groups[i].directOutsMode;
-					int offset = (tapIndex << (1 + N_GRP / 2)) + (i << 1);
-					if (auxExpanderPresent && gInfo->auxReturnsSolosMuteDry != 0 && tapIndex == 3) {
-						outputs[outputNum].setVoltage(groupTaps[offset + 0] * muteTrackWhenSoloAuxRetSlewer.out, 2 * i);
-						outputs[outputNum].setVoltage(groupTaps[offset + 1] * muteTrackWhenSoloAuxRetSlewer.out, 2 * i + 1);
-					}
-					else {
-						outputs[outputNum].setVoltage(groupTaps[offset + 0], 2 * i);
-						outputs[outputNum].setVoltage(groupTaps[offset + 1], 2 * i + 1);
-					}
-				}
+			float soloGain = muteTrackWhenSoloAuxRetSlewer.out;
+			for (int grp = 0; grp < N_GRP; grp += 2) {
+				simd::float_4 sig = gatherTwoStereo(groupTaps, &directGroupTapOffsets[grp]);
+				directOut->setVoltageSimd(simd::ifelse(directGroupSoloMasks[grp >> 1], sig * soloGain, sig), grp << 1);
 			}
 			
 			// Aux
 			// this uses one of the taps in the aux return signal flow (same signal flow as a group), and choice of tap is same as other direct outs
 			if (auxExpanderPresent) {
-				if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[0] < 4) {// global direct outs
-					tapIndex = gInfo->directOutPanStereoMomentCvLinearVol.cc4[0];
-					memcpy(outputs[outputNum].getVoltages(8), &auxTaps[(tapIndex << 3)], 4 * 8);
+				for (int auxi = 0; auxi < 4; auxi += 2) {
+					directOut->setVoltageSimd(gatherTwoStereo(auxTaps, &directAuxTapOffsets[auxi]), 8 + (auxi << 1));
 				}
-				else {// per aux direct outs
-					for (unsigned int i = 0; i < 4; i++) {
-						tapIndex = directOutsModeLocalAux.cc4[i];
-						int offset = (tapIndex << 3) + (i << 1);
-						outputs[outputNum].setVoltage(auxTaps[offset + 0], 8 + 2 * i);
-						outputs[outputNum].setVoltage(auxTaps[offset + 1], 8 + 2 * i + 1);
-					}
-				}		
 			}
 		}
 	}
 	
 	
-	void SetInsertTrackOuts(const int base) {// base is 0 or 8
+	void SetInsertTrackOuts(const int base) {// base is 0, 8, etc.
 		int outi = base >> 3;
 		if (outputs[INSERT_TRACK_OUTPUTS + outi].isConnected()) {
 			outputs[INSERT_TRACK_OUTPUTS + outi].setChannels(numChannels16);
@@ -906,12 +1065,62 @@ struct MixMaster : Module {
 	}
 
 
+	// the knobs, cables and menus mark their strip when they change, this catches what has no event or may be missed by one 
+	// (an undo of a knob, a knob that is still smoothing, a change in the number of channels of a cable) one strip per input refresh
+	void sweepSlowChanged() {
+		int strip = slowSweepStrip;
+		slowSweepStrip = (strip < N_TRK + N_GRP ? strip + 1 : 0);
+		if (strip < N_TRK) {
+			if (tracks[strip].isSlowChanged()) {
+				gInfo->setSlowDirty(strip);
+			}
+		}
+		else if (strip < N_TRK + N_GRP) {
+			if (groups[strip - N_TRK].isSlowChanged()) {
+				gInfo->setSlowDirty(strip);
+			}
+		}
+		else if (master->isSlowChanged()) {
+			gInfo->setSlowDirty(GlobalInfo::SLOW_MASTER);
+		}
+	}
+
+
+	void updateDirtySlowValues() {
+		TrkGrpBits dirty = gInfo->slowDirty;
+		if (!auxExpanderPresent) {
+			dirty.grp &= ~GlobalInfo::SLOW_AUX_MASK;// aux are all marked again when the expander comes
+		}
+		gInfo->slowDirty.reset();
+		for (int trk = 0; trk < N_TRK; trk++) {
+			if (dirty.test(N_TRK, trk)) {
+				tracks[trk].updateSlowValues();
+			}
+		}
+		for (int grp = 0; grp < N_GRP; grp++) {
+			if (dirty.test(N_TRK, N_TRK + grp)) {
+				groups[grp].updateSlowValues();
+			}
+		}
+		for (int auxi = 0; auxi < 4; auxi++) {
+			if (dirty.test(N_TRK, GlobalInfo::SLOW_AUX + auxi)) {
+				aux[auxi].updateSlowValues();
+			}
+		}
+		if (dirty.test(N_TRK, GlobalInfo::SLOW_MASTER)) {
+			master->updateSlowValues();
+		}
+	}
+
+
 	void processMuteSoloCvTriggers() {
+		// track mutes are in channels 0 to N_TRK-1 and track solos in channels N_TRK to 2*N_TRK-1 of the TRACK_MUTESOLO_INPUTS, 16 channels per input
 		int state;
-		if (inputs[TRACK_MUTESOLO_INPUTS + 0].isConnected()) {
-			for (int trk = 0; trk < N_TRK; trk++) {
+		for (int trk = 0; trk < N_TRK; trk++) {
+			Input* muteInput = &inputs[TRACK_MUTESOLO_INPUTS + (trk >> 4)];
+			if (muteInput->isConnected()) {
 				// track mutes
-				state = muteSoloCvTriggers[trk].process(inputs[TRACK_MUTESOLO_INPUTS + 0].getVoltage(trk));
+				state = muteSoloCvTriggers[trk].process(muteInput->getVoltage(trk & 0xF));
 				if (state != 0) {
 					if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[2] >= 2 ? tracks[trk].momentCvMuteLocal : gInfo->directOutPanStereoMomentCvLinearVol.cc4[2]) {
 						if (state == 1) {
@@ -925,11 +1134,11 @@ struct MixMaster : Module {
 				}
 			}
 		}
-		int soloInputNum = TRACK_MUTESOLO_INPUTS + N_TRK / 16;
-		if (inputs[soloInputNum].isConnected()) {
-			for (int trk = 0; trk < N_TRK; trk++) {
+		for (int trk = 0; trk < N_TRK; trk++) {
+			Input* soloInput = &inputs[TRACK_MUTESOLO_INPUTS + ((N_TRK + trk) >> 4)];
+			if (soloInput->isConnected()) {
 				// track solos
-				state = muteSoloCvTriggers[trk + N_TRK].process(inputs[soloInputNum].getVoltage((N_TRK == 16 ? 0 : 8) + trk));
+				state = muteSoloCvTriggers[trk + N_TRK].process(soloInput->getVoltage((N_TRK + trk) & 0xF));
 				if (state != 0) {
 					if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[2] >= 2 ? tracks[trk].momentCvSoloLocal : gInfo->directOutPanStereoMomentCvLinearVol.cc4[2]) {
 						if (state == 1) {
@@ -1107,6 +1316,7 @@ struct MixMasterWidget : ModuleWidget {
 			addParam(newFader = createParamCentered<MmSmallFaderWithLink>(mm2px(Vec(xTrck1 + 3.67 + 12.7 * i, 81.2)), module, TMixMaster::TRACK_FADER_PARAMS + i));
 			if (module) {
 				newFader->linkBitMaskSrc = &(module->gInfo->linkBitMask);
+				newFader->numTracks = N_TRK;
 				newFader->baseFaderParamId = TMixMaster::TRACK_FADER_PARAMS;
 				// VU meters
 				VuMeterTrack *newVU = createWidgetCentered<VuMeterTrack>(mm2px(Vec(xTrck1 + 12.7 * i, 81.2)));
@@ -1222,6 +1432,7 @@ struct MixMasterWidget : ModuleWidget {
 			addParam(newFader = createParamCentered<MmSmallFaderWithLink>(mm2px(Vec(xGrp1 + 3.67 + 12.7 * i, 81.2)), module, TMixMaster::GROUP_FADER_PARAMS + i));		
 			if (module) {
 				newFader->linkBitMaskSrc = &(module->gInfo->linkBitMask);
+				newFader->numTracks = N_TRK;
 				newFader->baseFaderParamId = TMixMaster::TRACK_FADER_PARAMS;
 				// VU meters
 				VuMeterTrack *newVU = createWidgetCentered<VuMeterTrack>(mm2px(Vec(xGrp1 + 12.7 * i, 81.2)));
@@ -1419,6 +1630,7 @@ struct MixMasterJrWidget : ModuleWidget {
 			addParam(newFader = createParamCentered<MmSmallFaderWithLink>(mm2px(Vec(xTrck1 + 3.67 + 12.7 * i, 81.2)), module, TMixMaster::TRACK_FADER_PARAMS + i));
 			if (module) {
 				newFader->linkBitMaskSrc = &(module->gInfo->linkBitMask);
+				newFader->numTracks = N_TRK;
 				newFader->baseFaderParamId = TMixMaster::TRACK_FADER_PARAMS;
 				// VU meters
 				VuMeterTrack *newVU = createWidgetCentered<VuMeterTrack>(mm2px(Vec(xTrck1 + 12.7 * i, 81.2)));
@@ -1529,6 +1741,7 @@ struct MixMasterJrWidget : ModuleWidget {
 			addParam(newFader = createParamCentered<MmSmallFaderWithLink>(mm2px(Vec(xGrp1 + 3.67 + 12.7 * i, 81.2)), module, TMixMaster::GROUP_FADER_PARAMS + i));		
 			if (module) {
 				newFader->linkBitMaskSrc = &(module->gInfo->linkBitMask);
+				newFader->numTracks = N_TRK;
 				newFader->baseFaderParamId = TMixMaster::TRACK_FADER_PARAMS;
 				// VU meters
 				VuMeterTrack *newVU = createWidgetCentered<VuMeterTrack>(mm2px(Vec(xGrp1 + 12.7 * i, 81.2)));
@@ -1637,5 +1850,350 @@ struct MixMasterJrWidget : ModuleWidget {
 
 
 
+struct MixMaster32Widget : ModuleWidget {
+	static const int N_TRK = 32;
+	static const int N_GRP = 4;
+
+
+	#include "MixMasterWidget.hpp"
+
+
+	// Module's widget
+	// --------------------
+
+	MixMaster32Widget(TMixMaster *module) {
+		setModule(module);
+
+		// Main panels from Inkscape
+        setPanel(APP->window->loadSvg(asset::plugin(pluginInstance, "res/dark/mixmaster32.svg")));
+		SvgPanel* svgPanel = static_cast<SvgPanel*>(getPanel());
+		panelBorder = findBorder(svgPanel->fb);
+		
+		// Inserts and CVs
+		static const float xIns = 13.8;
+		// Insert outputs
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8)), module, TMixMaster::INSERT_TRACK_OUTPUTS + 0));
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 1)), module, TMixMaster::INSERT_TRACK_OUTPUTS + 1));
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 2)), module, TMixMaster::INSERT_GRP_AUX_OUTPUT));
+		// Insert inputs
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 3)), module, TMixMaster::INSERT_TRACK_INPUTS + 0));
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 4)), module, TMixMaster::INSERT_TRACK_INPUTS + 1));
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 5)), module, TMixMaster::INSERT_GRP_AUX_INPUT));
+		// Mute, solo and other CVs
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 7)), module, TMixMaster::TRACK_MUTESOLO_INPUTS + 0));
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 8)), module, TMixMaster::TRACK_MUTESOLO_INPUTS + 2));
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns, 12.8 + 10.85 * 9)), module, TMixMaster::GRPM_MUTESOLO_INPUT));
+		
+		// Inserts, CVs and direct outs of tracks 17-32, between the two banks of tracks
+		static const float xIns2 = xIns + 228.6;
+		// Insert outputs
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8)), module, TMixMaster::INSERT_TRACK_OUTPUTS + 2));
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 1)), module, TMixMaster::INSERT_TRACK_OUTPUTS + 3));
+		// Insert inputs
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 2)), module, TMixMaster::INSERT_TRACK_INPUTS + 2));
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 3)), module, TMixMaster::INSERT_TRACK_INPUTS + 3));
+		// Mute and solo CVs
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 5)), module, TMixMaster::TRACK_MUTESOLO_INPUTS + 1));
+		addInput(createInputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 6)), module, TMixMaster::TRACK_MUTESOLO_INPUTS + 3));
+		// Direct outputs and fade CV output
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 8)), module, TMixMaster::DIRECT_OUTPUTS + 2));
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 9)), module, TMixMaster::DIRECT_OUTPUTS + 3));
+		addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xIns2, 12.8 + 10.85 * 10)), module, TMixMaster::FADE_CV_OUTPUT + 1));
+		
+	
+		// Tracks
+		static const float xTrck1 = 11.43 + 20.32;
+		for (int i = 0; i < N_TRK; i++) {
+			const float xTrck = xTrck1 + (i >= 16 ? 25.4f : 0.0f);// tracks 17-32 are right of the second insert column
+			// Labels
+			addChild(trackDisplays[i] = createWidget<TrackDisplay<TMixMaster::MixerTrack>>(mm2px(Vec(xTrck + 12.7 * i - 5.3, 2.2))));
+			if (module) {
+				// trackDisplays[i]->tabNextFocus = // done after the for loop
+				trackDisplays[i]->colorAndCloak = &(module->gInfo->colorAndCloak);
+				trackDisplays[i]->dispColorLocal = &(module->tracks[i].dispColorLocal);				
+				trackDisplays[i]->tracks = &(module->tracks[0]);
+				trackDisplays[i]->trackNumSrc = i;
+				trackDisplays[i]->auxExpanderPresentPtr = &(module->auxExpanderPresent);
+				trackDisplays[i]->numTracks = N_TRK;
+				trackDisplays[i]->updateTrackLabelRequestPtr = &(module->updateTrackLabelRequest);
+				trackDisplays[i]->trackOrGroupResetInAuxPtr = &(module->trackOrGroupResetInAux);
+				trackDisplays[i]->trackMoveInAuxRequestPtr = &(module->trackMoveInAuxRequest);
+				trackDisplays[i]->inputWidgets = inputWidgets;
+				trackDisplays[i]->idPtr = &(module->id);
+				trackDisplays[i]->hpfParamQuantity = module->paramQuantities[TMixMaster::TRACK_HPCUT_PARAMS + i];
+				trackDisplays[i]->lpfParamQuantity = module->paramQuantities[TMixMaster::TRACK_LPCUT_PARAMS + i];
+			}
+			// HPF lights
+			addChild(createLightCentered<TinyLight<GreenLight>>(mm2px(Vec(xTrck - 4.17 + 12.7 * i, 8.3)), module, TMixMaster::TRACK_HPF_LIGHTS + i));	
+			addParam(createParamCentered<FilterCutWidget>(mm2px(Vec(xTrck - 4.17 + 12.7 * i, 8.3)), module, TMixMaster::TRACK_HPCUT_PARAMS + i));				
+			// LPF lights
+			addChild(createLightCentered<TinyLight<BlueLight>>(mm2px(Vec(xTrck + 4.17 + 12.7 * i, 8.3)), module, TMixMaster::TRACK_LPF_LIGHTS + i));	
+			addParam(createParamCentered<FilterCutWidget>(mm2px(Vec(xTrck + 4.17 + 12.7 * i, 8.3)), module, TMixMaster::TRACK_LPCUT_PARAMS + i));	
+			// Left inputs
+			addInput(inputWidgets[i + 0] = createInputCentered<MmPort>(mm2px(Vec(xTrck + 12.7 * i, 12.8)), module, TMixMaster::TRACK_SIGNAL_INPUTS + 2 * i + 0));			
+			// Right inputs
+			addInput(inputWidgets[i + N_TRK] = createInputCentered<MmPort>(mm2px(Vec(xTrck + 12.7 * i, 21.8)), module, TMixMaster::TRACK_SIGNAL_INPUTS + 2 * i + 1));	
+			// Volume inputs
+			addInput(inputWidgets[i + N_TRK * 2] = createInputCentered<MmPort>(mm2px(Vec(xTrck + 12.7 * i, 31.5)), module, TMixMaster::TRACK_VOL_INPUTS + i));			
+			// Pan inputs
+			addInput(inputWidgets[i + N_TRK * 3] = createInputCentered<MmPort>(mm2px(Vec(xTrck + 12.7 * i, 40.5)), module, TMixMaster::TRACK_PAN_INPUTS + i));			
+			// Pan knobs
+			MmSmallKnobGreyWithArc *panKnobTrack;
+			svgPanel->fb->addChild(createWidgetCentered<Dots7p5cSvg>(mm2px(Vec(xTrck + 12.7 * i, 51.8))));
+			addParam(panKnobTrack = createParamCentered<MmSmallKnobGreyWithArc>(mm2px(Vec(xTrck + 12.7 * i, 51.8)), module, TMixMaster::TRACK_PAN_PARAMS + i));
+			if (module) {
+				panKnobTrack->detailsShowSrc = &(module->gInfo->colorAndCloak.cc4[detailsShow]);
+				panKnobTrack->cloakedModeSrc = &(module->gInfo->colorAndCloak.cc4[cloakedMode]);
+				panKnobTrack->paramWithCV = &(module->tracks[i].pan);
+				panKnobTrack->paramCvConnected = &(module->tracks[i].panCvConnected);
+				panKnobTrack->dispColorGlobalSrc = &(module->gInfo->colorAndCloak.cc4[dispColorGlobal]);
+				panKnobTrack->dispColorLocalSrc = &(module->tracks[i].dispColorLocal);
+			}
+			
+			// Faders
+			MmSmallFaderWithLink *newFader;
+			addParam(newFader = createParamCentered<MmSmallFaderWithLink>(mm2px(Vec(xTrck + 3.67 + 12.7 * i, 81.2)), module, TMixMaster::TRACK_FADER_PARAMS + i));
+			if (module) {
+				newFader->linkBitMaskSrc = &(module->gInfo->linkBitMask);
+				newFader->numTracks = N_TRK;
+				newFader->baseFaderParamId = TMixMaster::TRACK_FADER_PARAMS;
+				// VU meters
+				VuMeterTrack *newVU = createWidgetCentered<VuMeterTrack>(mm2px(Vec(xTrck + 12.7 * i, 81.2)));
+				newVU->srcLevels = module->tracks[i].vu.vuValues;
+				newVU->srcMuteGhost = &(module->tracks[i].fadeGainScaledWithSolo);
+				newVU->colorThemeGlobal = &(module->gInfo->colorAndCloak.cc4[vuColorGlobal]);
+				newVU->colorThemeLocal = &(module->tracks[i].vuColorThemeLocal);
+				addChild(newVU);
+				// Fade pointers
+				CvAndFadePointerTrack *newFP = createWidgetCentered<CvAndFadePointerTrack>(mm2px(Vec(xTrck - 2.95 + 12.7 * i, 81.2)));
+				newFP->srcParam = &(module->params[TMixMaster::TRACK_FADER_PARAMS + i]);
+				newFP->srcParamWithCV = &(module->tracks[i].paramWithCV);
+				newFP->colorAndCloak = &(module->gInfo->colorAndCloak);
+				newFP->srcFadeGain = &(module->tracks[i].fadeGain);
+				newFP->srcFadeRate = module->tracks[i].fadeRate;
+				newFP->dispColorLocalPtr = &(module->tracks[i].dispColorLocal);
+				addChild(newFP);				
+			}
+			
+			
+			// Mutes
+			MmMuteFadeButtonWithClear* newMuteFade;
+			addParam(newMuteFade = createParamCentered<MmMuteFadeButtonWithClear>(mm2px(Vec(xTrck + 12.7 * i, 109.8)), module, TMixMaster::TRACK_MUTE_PARAMS + i));
+			if (module) {
+				newMuteFade->type = module->tracks[i].fadeRate;
+				newMuteFade->muteParams = &module->params[TMixMaster::TRACK_MUTE_PARAMS];
+				newMuteFade->baseMuteParamId = TMixMaster::TRACK_MUTE_PARAMS;
+				newMuteFade->numTracksAndGroups = N_TRK + N_GRP;
+			}
+			// Solos
+			MmSoloButtonMutex *newSoloButton;
+			addParam(newSoloButton = createParamCentered<MmSoloButtonMutex>(mm2px(Vec(xTrck + 12.7 * i, 116.1)), module, TMixMaster::TRACK_SOLO_PARAMS + i));
+			newSoloButton->soloParams =  module ? &module->params[TMixMaster::TRACK_SOLO_PARAMS] : NULL;
+			newSoloButton->baseSoloParamId = TMixMaster::TRACK_SOLO_PARAMS;
+			newSoloButton->numTracks = N_TRK;
+			newSoloButton->numGroups = N_GRP;
+			// Group dec
+			MmGroupMinusButtonNotify *newGrpMinusButton;
+			addChild(newGrpMinusButton = createWidgetCentered<MmGroupMinusButtonNotify>(mm2px(Vec(xTrck - 3.73 + 12.7 * i - 0.75, 123.1))));
+			if (module) {
+				newGrpMinusButton->sourceParam = &(module->params[TMixMaster::GROUP_SELECT_PARAMS + i]);
+				newGrpMinusButton->numGroups = (float)N_GRP;
+			}
+			// Group inc
+			MmGroupPlusButtonNotify *newGrpPlusButton;
+			addChild(newGrpPlusButton = createWidgetCentered<MmGroupPlusButtonNotify>(mm2px(Vec(xTrck + 3.77 + 12.7 * i + 0.75, 123.1))));
+			if (module) {
+				newGrpPlusButton->sourceParam = &(module->params[TMixMaster::GROUP_SELECT_PARAMS + i]);
+				newGrpPlusButton->numGroups = (float)N_GRP;
+			}
+			// Group select displays
+			GroupSelectDisplay* groupSelectDisplay;
+			addParam(groupSelectDisplay = createParamCentered<GroupSelectDisplay>(mm2px(Vec(xTrck + 12.7 * i, 123.1)), module, TMixMaster::GROUP_SELECT_PARAMS + i));
+			if (module) {
+				groupSelectDisplay->srcColor = &(module->gInfo->colorAndCloak);
+				groupSelectDisplay->srcColorLocal = &(module->tracks[i].dispColorLocal);
+				groupSelectDisplay->numGroups = N_GRP;
+			}
+		}
+		for (int i = 0; i < N_TRK; i++) {
+			trackDisplays[i]->tabNextFocus = trackDisplays[(i + 1) % N_TRK];
+		}
+		
+		// Monitor outputs and groups
+		static const float xGrp1 = 217.17 + 20.32 + 228.6;
+		for (int i = 0; i < N_GRP; i++) {
+			// Monitor outputs
+			if (i > 0) {
+				addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xGrp1 + 12.7 * (i), 11.5)), module, TMixMaster::DIRECT_OUTPUTS + (i < 3 ? i - 1 : N_TRK / 8)));// 1-8, 9-16, group/aux
+			}
+			else {
+				addOutput(createOutputCentered<MmPortGold>(mm2px(Vec(xGrp1 + 12.7 * (0), 11.5)), module, TMixMaster::FADE_CV_OUTPUT));				
+			}
+			// Labels
+			addChild(groupDisplays[i] = createWidget<GroupDisplay<TMixMaster::MixerGroup>>(mm2px(Vec(xGrp1 + 12.7 * i - 5.3, 21.0))));
+			if (module) {
+				// groupDisplays[i]->tabNextFocus = // done after the for loop
+				groupDisplays[i]->colorAndCloak = &(module->gInfo->colorAndCloak);
+				groupDisplays[i]->dispColorLocal = &(module->groups[i].dispColorLocal);
+				groupDisplays[i]->srcGroup = &(module->groups[i]);
+				groupDisplays[i]->updateTrackLabelRequestPtr = &(module->updateTrackLabelRequest);
+				groupDisplays[i]->trackOrGroupResetInAuxPtr = &(module->trackOrGroupResetInAux);
+				groupDisplays[i]->auxExpanderPresentPtr = &(module->auxExpanderPresent);
+				groupDisplays[i]->numTracks = N_TRK;
+				groupDisplays[i]->hpfParamQuantity = module->paramQuantities[TMixMaster::GROUP_HPCUT_PARAMS + i];
+				groupDisplays[i]->lpfParamQuantity = module->paramQuantities[TMixMaster::GROUP_LPCUT_PARAMS + i];
+			}
+			// HPF lights
+			addChild(createLightCentered<TinyLight<GreenLight>>(mm2px(Vec(xGrp1 - 4.17 + 12.7 * i, 27.0)), module, TMixMaster::GROUP_HPF_LIGHTS + i));	
+			addParam(createParamCentered<FilterCutWidget>(mm2px(Vec(xGrp1 - 4.17 + 12.7 * i, 27.0)), module, TMixMaster::GROUP_HPCUT_PARAMS + i));				
+			// LPF lights
+			addChild(createLightCentered<TinyLight<BlueLight>>(mm2px(Vec(xGrp1 + 4.17 + 12.7 * i, 27.0)), module, TMixMaster::GROUP_LPF_LIGHTS + i));	
+			addParam(createParamCentered<FilterCutWidget>(mm2px(Vec(xGrp1 + 4.17 + 12.7 * i, 27.0)), module, TMixMaster::GROUP_LPCUT_PARAMS + i));				
+			// Volume inputs
+			addInput(createInputCentered<MmPort>(mm2px(Vec(xGrp1 + 12.7 * i, 31.5)), module, TMixMaster::GROUP_VOL_INPUTS + i));			
+			// Pan inputs
+			addInput(createInputCentered<MmPort>(mm2px(Vec(xGrp1 + 12.7 * i, 40.5)), module, TMixMaster::GROUP_PAN_INPUTS + i));			
+			// Pan knobs
+			MmSmallKnobGreyWithArc *panKnobGroup;
+			svgPanel->fb->addChild(createWidgetCentered<Dots7p5cSvg>(mm2px(Vec(xGrp1 + 12.7 * i, 51.8))));
+			addParam(panKnobGroup = createParamCentered<MmSmallKnobGreyWithArc>(mm2px(Vec(xGrp1 + 12.7 * i, 51.8)), module, TMixMaster::GROUP_PAN_PARAMS + i));
+			if (module) {
+				panKnobGroup->detailsShowSrc = &(module->gInfo->colorAndCloak.cc4[detailsShow]);
+				panKnobGroup->cloakedModeSrc = &(module->gInfo->colorAndCloak.cc4[cloakedMode]);
+				panKnobGroup->paramWithCV = &(module->groups[i].pan);
+				panKnobGroup->paramCvConnected = &(module->groups[i].panCvConnected);
+				panKnobGroup->dispColorGlobalSrc = &(module->gInfo->colorAndCloak.cc4[dispColorGlobal]);
+				panKnobGroup->dispColorLocalSrc = &(module->groups[i].dispColorLocal);
+			}
+			
+			// Faders
+			MmSmallFaderWithLink *newFader;
+			addParam(newFader = createParamCentered<MmSmallFaderWithLink>(mm2px(Vec(xGrp1 + 3.67 + 12.7 * i, 81.2)), module, TMixMaster::GROUP_FADER_PARAMS + i));		
+			if (module) {
+				newFader->linkBitMaskSrc = &(module->gInfo->linkBitMask);
+				newFader->numTracks = N_TRK;
+				newFader->baseFaderParamId = TMixMaster::TRACK_FADER_PARAMS;
+				// VU meters
+				VuMeterTrack *newVU = createWidgetCentered<VuMeterTrack>(mm2px(Vec(xGrp1 + 12.7 * i, 81.2)));
+				newVU->srcLevels = module->groups[i].vu.vuValues;
+				newVU->srcMuteGhost = &(module->groups[i].fadeGainScaled);
+				newVU->colorThemeGlobal = &(module->gInfo->colorAndCloak.cc4[vuColorGlobal]);
+				newVU->colorThemeLocal = &(module->groups[i].vuColorThemeLocal);
+				addChild(newVU);
+				// Fade pointers
+				CvAndFadePointerGroup *newFP = createWidgetCentered<CvAndFadePointerGroup>(mm2px(Vec(xGrp1 - 2.95 + 12.7 * i, 81.2)));
+				newFP->srcParam = &(module->params[TMixMaster::GROUP_FADER_PARAMS + i]);
+				newFP->srcParamWithCV = &(module->groups[i].paramWithCV);
+				newFP->colorAndCloak = &(module->gInfo->colorAndCloak);
+				newFP->srcFadeGain = &(module->groups[i].fadeGain);
+				newFP->srcFadeRate = module->groups[i].fadeRate;
+				newFP->dispColorLocalPtr = &(module->groups[i].dispColorLocal);
+				addChild(newFP);				
+			}
+
+			// Mutes
+			MmMuteFadeButtonWithClear* newMuteFade;
+			addParam(newMuteFade = createParamCentered<MmMuteFadeButtonWithClear>(mm2px(Vec(xGrp1 + 12.7 * i, 109.8)), module, TMixMaster::GROUP_MUTE_PARAMS + i));
+			if (module) {
+				newMuteFade->type = module->groups[i].fadeRate;
+				newMuteFade->muteParams = &module->params[TMixMaster::TRACK_MUTE_PARAMS];
+				newMuteFade->baseMuteParamId = TMixMaster::TRACK_MUTE_PARAMS;
+				newMuteFade->numTracksAndGroups = N_TRK + N_GRP;
+			}
+			// Solos
+			MmSoloButtonMutex* newSoloButton;
+			addParam(newSoloButton = createParamCentered<MmSoloButtonMutex>(mm2px(Vec(xGrp1 + 12.7 * i, 116.1)), module, TMixMaster::GROUP_SOLO_PARAMS + i));
+			newSoloButton->soloParams =  module ? &module->params[TMixMaster::TRACK_SOLO_PARAMS] : NULL;
+			newSoloButton->baseSoloParamId = TMixMaster::TRACK_SOLO_PARAMS;
+			newSoloButton->numTracks = N_TRK;
+			newSoloButton->numGroups = N_GRP;
+		}
+		for (int i = 0; i < N_GRP; i++) {
+			groupDisplays[i]->tabNextFocus = groupDisplays[(i + 1) % N_GRP];
+		}
+	
+		// Master inputs
+		addInput(createInputCentered<MmPort>(mm2px(Vec(289.62 + 228.6, 12.8)), module, TMixMaster::CHAIN_INPUTS + 0));			
+		addInput(createInputCentered<MmPort>(mm2px(Vec(289.62 + 228.6, 21.8)), module, TMixMaster::CHAIN_INPUTS + 1));			
+		
+		// Master outputs
+		addOutput(createOutputCentered<MmPort>(mm2px(Vec(300.12 + 228.6, 12.8)), module, TMixMaster::MAIN_OUTPUTS + 0));			
+		addOutput(createOutputCentered<MmPort>(mm2px(Vec(300.12 + 228.6, 21.8)), module, TMixMaster::MAIN_OUTPUTS + 1));			
+		
+		// Master label
+		addChild(masterDisplay = createWidget<MasterDisplay>(mm2px(Vec(294.82 + 228.6 - 7.25, 31.25 - 2.65))));
+		if (module) {
+			masterDisplay->dcBlock = &(module->master->dcBlock);
+			masterDisplay->clipping = &(module->master->clipping);
+			masterDisplay->fadeRate = &(module->master->fadeRate);
+			masterDisplay->fadeProfile = &(module->master->fadeProfile);
+			masterDisplay->vuColorThemeLocal = &(module->master->vuColorThemeLocal);
+			masterDisplay->directOutPanStereoMomentCvLinearVol = &(module->gInfo->directOutPanStereoMomentCvLinearVol);
+			masterDisplay->momentCvMuteLocal = &(module->master->momentCvMuteLocal);
+			masterDisplay->momentCvDimLocal = &(module->master->momentCvDimLocal);
+			masterDisplay->momentCvMonoLocal = &(module->master->momentCvMonoLocal);
+			masterDisplay->dispColorLocal = &(module->master->dispColorLocal);
+			masterDisplay->chainOnly = &(module->master->chainOnly);
+			masterDisplay->dimGain = &(module->master->dimGain);
+			masterDisplay->masterLabel = module->master->masterLabel;
+			masterDisplay->dimGainIntegerDB = &(module->master->dimGainIntegerDB);
+			masterDisplay->colorAndCloak = &(module->gInfo->colorAndCloak);
+			masterDisplay->idSrc = &(module->id);
+			masterDisplay->masterFaderScalesSendsSrc = &(module->gInfo->masterFaderScalesSends);
+		}
+		
+		// Master fader
+		addParam(createParamCentered<MmBigFader>(mm2px(Vec(300.17 + 228.6, 70.3)), module, TMixMaster::MAIN_FADER_PARAM));
+		if (module) {
+			// VU meter
+			VuMeterMaster *newVU = createWidgetCentered<VuMeterMaster>(mm2px(Vec(294.82 + 228.6, 70.3)));
+			newVU->srcLevels = module->master->vu.vuValues;
+			newVU->srcMuteGhost = &(module->master->fadeGainScaled);
+			newVU->colorThemeGlobal = &(module->gInfo->colorAndCloak.cc4[vuColorGlobal]);
+			newVU->colorThemeLocal = &(module->master->vuColorThemeLocal);
+			newVU->clippingPtr = &(module->master->clipping);
+			addChild(newVU);
+			// Fade pointer
+			CvAndFadePointerMaster *newFP = createWidgetCentered<CvAndFadePointerMaster>(mm2px(Vec(294.82 + 228.6 - 3.4, 70.3)));
+			newFP->srcParam = &(module->params[TMixMaster::MAIN_FADER_PARAM]);
+			newFP->srcParamWithCV = &(module->master->paramWithCV);
+			newFP->colorAndCloak = &(module->gInfo->colorAndCloak);
+			newFP->srcFadeGain = &(module->master->fadeGain);
+			newFP->srcFadeRate = &(module->master->fadeRate);
+			addChild(newFP);				
+		}
+		
+		// Master mute
+		MmMuteFadeButton* newMuteFade;
+		addParam(newMuteFade = createParamCentered<MmMuteFadeButton>(mm2px(Vec(294.82 + 228.6, 109.8)), module, TMixMaster::MAIN_MUTE_PARAM));
+		if (module) {
+			newMuteFade->type = &(module->master->fadeRate);
+		}
+		
+		// Master dim
+		addParam(createParamCentered<MmDimButton>(mm2px(Vec(289.42 + 228.6, 116.1)), module, TMixMaster::MAIN_DIM_PARAM));
+		
+		// Master mono
+		addParam(createParamCentered<MmMonoButton>(mm2px(Vec(300.22 + 228.6, 116.1)), module, TMixMaster::MAIN_MONO_PARAM));
+	}
+};
+
+
+
 Model *modelMixMaster = createModel<MixMaster<16, 4>, MixMasterWidget>("MixMaster");
 Model *modelMixMasterJr = createModel<MixMaster<8, 2>, MixMasterJrWidget>("MixMasterJr");
+
+
+Model *modelMixMaster32 = createModel<MixMaster<32, 4>, MixMaster32Widget>("MixMaster32");
+
+
+#ifdef MM_BENCH
+// 64-track engine, for bench/ModuleBench only (see Makefile): it has no panel, which would be over a meter wide
+struct MixMaster64BenchWidget : ModuleWidget {
+	MixMaster64BenchWidget(MixMaster<64, 4> *module) {
+		setModule(module);
+	}
+};
+
+Model *modelMixMaster64 = createModel<MixMaster<64, 4>, MixMaster64BenchWidget>("MixMaster64");
+#endif
@@ -31,21 +31,32 @@ struct GlobalInfo {
 	PackedBytes4 colorAndCloak;// see enum called ccIds for fields
 	bool symmetricalFade;
 	bool fadeCvOutsWithVolCv;
-	unsigned long linkBitMask;// 20 bits for 16 trks (trk1 = lsb) + 4 grps (grp4 = msb), or 10 bits for 8trk + 2grp
+	TrkGrpBits linkBitMask;// N_TRK bits in trk (trk1 = lsb), N_GRP bits in grp (grp1 = lsb)
 	int8_t filterPos;// 0 = pre insert, 1 = post insert, 2 = per track
 	int8_t groupedAuxReturnFeedbackProtection;
 	uint16_t ecoMode;// all 1's means yes, 0 means no
+	int8_t ecoAdaptive;// 0 is eco as set by ecoMode, 1 is a control-rate divider picked from the measured cost of process() (ecoMode is then ignored)
+	int8_t ecoBudget;// adaptive eco budget, in percent of the sample period that the mixer (with its expander) may take
 	int8_t masterFaderScalesSends;// 1 = yes 
 	int8_t polySpreadVandP;// allow V and P poly spread of channel 1 to other channels
 	
 
 	// no need to save, with reset
-	unsigned long soloBitMask;// when = 0ul, nothing to do, when non-zero, a track must check its solo to see if it should play
+	TrkGrpBits soloBitMask;// when none, nothing to do, when any, a track must check its solo to see if it should play
 	int returnSoloBitMask;
 	float sampleTime;
+	float dormantDelaySamples;// GlobalConst::dormantDelay in samples, see onSampleRateChange()
 	float oldFaders[N_TRK + N_GRP];
+	TrkGrpBits linkBitMaskSeen;// linkBitMask when oldFaders were last synced to the faders
+	TrkGrpBits slowDirty;// strips whose updateSlowValues() is due, see SLOW_* below for bit positions
+	uint16_t ecoMask;// control-rate divider minus one (0, 1, 3, 7 or 15), the eco staggers are the phases of refreshCounter & ecoMask
+	int ecoHold;// light refresh periods to wait before the adaptive eco can change ecoMask again
+	int ecoSettle;// light refresh periods to wait before the measured cost is that of the current ecoMask (the EcoMeter smooths it)
+	float ecoMinNs;// lowest cost measured since the adaptive eco last looked at it
+	float ecoCosts[5];// cost last measured by the adaptive eco at each divider (1, 2, 4, 8, 16), ecoCosts[0] is the baseline
 
 	// no need to save, no reset
+	std::atomic<uint64_t> slowDirtyRequests[2] = {{0}, {0}};// slowDirty bits or-ed by the ui thread, see SlowDirtyRequest
 	Param *paMute;// all 20 (10) solos are here (track and group)
 	Param *paSolo;// all 20 (10) solos are here (track and group)
 	Param *paFade;// all 20 (10) faders are here (track and group)
@@ -53,37 +64,64 @@ struct GlobalInfo {
 	float *values20;
 	float maxTGFader;
 	float fadeRates[N_TRK + N_GRP] = {};// reset and json done in tracks and groups. fade rates for tracks and groups
-	int groupUsage[N_GRP + 1];// bit 0 of first element shows if first track mapped to first group, etc... bitfields are mutually exclusive between all first 4 ints, last int is bitwise OR of first 4 ints.
+	uint64_t groupUsage[N_GRP + 1];// bit 0 of first element shows if first track mapped to first group, etc... bitfields are mutually exclusive between all first 4 ints, last int is bitwise OR of first 4 ints.
+	VuMeterBank<N_TRK + N_GRP + 4 + 1> vuBank;// VUs of tracks, groups, aux and master are added to this during the mixer's process(), and processed at its end
 
 	
-	void clearLinked(int index) {linkBitMask &= ~(1 << index);}
-	void setLinked(int index) {linkBitMask |= (1 << index);}
+	// indexes in slowDirty: tracks then groups (same as the other masks), then aux then master (in the grp word after the groups)
+	static const int SLOW_AUX = N_TRK + N_GRP;
+	static const int SLOW_MASTER = N_TRK + N_GRP + 4;
+	static constexpr uint64_t SLOW_TRK_MASK = lowBits64(N_TRK);// trk word
+	static constexpr uint64_t SLOW_AUX_MASK = (uint64_t)0xF << N_GRP;// grp word
+	static constexpr uint64_t SLOW_GRP_ALL_MASK = lowBits64(N_GRP + 4 + 1);// grp word
+	
+	void setSlowDirty(int index) {slowDirty.set(N_TRK, index);}
+	void setAllSlowDirty() {slowDirty.trk = SLOW_TRK_MASK; slowDirty.grp = SLOW_GRP_ALL_MASK;}
+	// menus, knobs, cables and resets run in the ui thread, so they can't touch slowDirty; they or their strips into slowDirtyRequests,
+	// which takeSlowDirtyRequests() moves into slowDirty at the next sample
+	SlowDirtyRequest slowDirtyRequest(int index) {
+		SlowDirtyRequest req;
+		req.words = slowDirtyRequests;
+		req.bits.set(N_TRK, index);
+		return req;
+	}
+	SlowDirtyRequest slowDirtyRequestAll() {
+		SlowDirtyRequest req;
+		req.words = slowDirtyRequests;
+		req.bits.trk = SLOW_TRK_MASK;
+		req.bits.grp = SLOW_GRP_ALL_MASK;
+		return req;
+	}
+	void requestSlowDirty(int index) {slowDirtyRequest(index).request();}
+	void requestAllSlowDirty() {slowDirtyRequestAll().request();}
+	void takeSlowDirtyRequests() {// engine thread, at every sample
+		if (slowDirtyRequests[0].load(std::memory_order_relaxed) != 0) {
+			slowDirty.trk |= slowDirtyRequests[0].exchange(0, std::memory_order_acquire);
+		}
+		if (slowDirtyRequests[1].load(std::memory_order_relaxed) != 0) {
+			slowDirty.grp |= slowDirtyRequests[1].exchange(0, std::memory_order_acquire);
+		}
+	}
+
+	bool isLinked(int index) const {return linkBitMask.test(N_TRK, index);}
+	void clearLinked(int index) {linkBitMask.clear(N_TRK, index);}
+	void setLinked(int index) {linkBitMask.set(N_TRK, index);}
 	void setLinked(int index, bool state) {if (state) setLinked(index); else clearLinked(index);}
-	void toggleLinked(int index) {linkBitMask ^= (1 << index);}
+	void toggleLinked(int index) {linkBitMask.toggle(N_TRK, index);}
 	
 	// track and group solos
 	void updateSoloBitMask() {
-		soloBitMask = 0ul;
-		for (unsigned long trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
+		soloBitMask.reset();
+		for (int trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
 			updateSoloBit(trkOrGrp);
 		}
 	}
-	void updateSoloBit(unsigned long trkOrGrp) {
-		if (trkOrGrp < N_TRK) {
-			if (paSolo[trkOrGrp].getValue() >= 0.5f) {
-				soloBitMask |= (1 << trkOrGrp);
-			}
-			else {
-				soloBitMask &= ~(1 << trkOrGrp);
-			}	
+	void updateSoloBit(int trkOrGrp) {// tracks and groups
+		if (paSolo[trkOrGrp].getValue() >= 0.5f) {
+			soloBitMask.set(N_TRK, trkOrGrp);
 		}
-		else {// trkOrGrp >= N_TRK
-			if (paSolo[trkOrGrp].getValue() >= 0.5f) {
-				soloBitMask |= (1 << trkOrGrp);
-			}
-			else {
-				soloBitMask &= ~(1 << trkOrGrp);
-			}
+		else {
+			soloBitMask.clear(N_TRK, trkOrGrp);
 		}
 	}		
 			
@@ -102,10 +140,10 @@ struct GlobalInfo {
 	// linked faders
 	void processLinked(int trgOrGrpNum, float newFader) {
 		if (newFader != oldFaders[trgOrGrpNum]) {
-			if (linkBitMask != 0l && isLinked(&linkBitMask, trgOrGrpNum)) {
+			if (linkBitMask.any() && isLinked(trgOrGrpNum)) {
 				float delta = newFader - oldFaders[trgOrGrpNum];
 				for (int trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
-					if (isLinked(&linkBitMask, trkOrGrp) && trkOrGrp != trgOrGrpNum) {
+					if (isLinked(trkOrGrp) && trkOrGrp != trgOrGrpNum) {
 						float newValue = paFade[trkOrGrp].getValue() + delta;
 						newValue = clamp(newValue, 0.0f, maxTGFader);
 						paFade[trkOrGrp].setValue(newValue);
@@ -119,11 +157,11 @@ struct GlobalInfo {
 
 	// linked fade
 	void fadeOtherLinkedTracks(int trkOrGrpNum, float newTarget) {
-		if ((linkBitMask == 0l) || !isLinked(&linkBitMask, trkOrGrpNum)) {
+		if (!linkBitMask.any() || !isLinked(trkOrGrpNum)) {
 			return;
 		}
 		for (int trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
-			if (trkOrGrp != trkOrGrpNum && isLinked(&linkBitMask, trkOrGrp) && fadeRates[trkOrGrp] >= GlobalConst::minFadeRate) {
+			if (trkOrGrp != trkOrGrpNum && isLinked(trkOrGrp) && fadeRates[trkOrGrp] >= GlobalConst::minFadeRate) {
 				if (newTarget >= 0.5f && paMute[trkOrGrp].getValue() >= 0.5f) {
 					paMute[trkOrGrp].setValue(0.0f);
 				}
@@ -134,26 +172,112 @@ struct GlobalInfo {
 		}		
 	}
 	
-	void updateGroupUsage() {
-		// clear groupUsage for all track in all groups, and bitwise OR int also
-		for (int gu = 0; gu < (N_GRP + 1); gu++) {
-			groupUsage[gu] = 0;
-		}
+	bool updateGroupUsage() {// returns true when a track changed group
+		uint64_t newGroupUsage[N_GRP + 1] = {};
 		
 		for (int trk = 0; trk < N_TRK; trk++) {
 			// set groupUsage for this track in the new group
 			int group = (int)(paGroup[trk].getValue() + 0.5f);
 			if (group > 0) {
-				groupUsage[group - 1] |= (1 << trk);
+				newGroupUsage[group - 1] |= ((uint64_t)1 << trk);
 			}
 		}
 		
 		// Bitwise OR of first ints in last int
 		for (int grp = 0; grp < N_GRP; grp++) {
-			groupUsage[N_GRP] |= groupUsage[grp];
+			newGroupUsage[N_GRP] |= newGroupUsage[grp];
+		}
+		
+		bool changed = false;
+		for (int gu = 0; gu < (N_GRP + 1); gu++) {
+			if (newGroupUsage[gu] != groupUsage[gu]) {
+				groupUsage[gu] = newGroupUsage[gu];
+				changed = true;
+			}
 		}
+		return changed;
 	}	
 	
+	// marks the strips whose slow values depend on what changed since the last input refresh in the solos, groups and links
+	void updateSlowDirty() {
+		// solos and groups: soloGain of tracks and aux
+		TrkGrpBits oldSoloBitMask = soloBitMask;
+		updateSoloBitMask();
+		bool groupsChanged = updateGroupUsage();
+		if (soloBitMask != oldSoloBitMask) {
+			slowDirty.trk |= SLOW_TRK_MASK;
+			slowDirty.grp |= SLOW_AUX_MASK;
+		}
+		else if (groupsChanged && soloBitMask.any()) {
+			slowDirty.trk |= SLOW_TRK_MASK;
+		}
+		
+		// linked faders
+		if (linkBitMask != linkBitMaskSeen) {
+			// start from where the faders are now, so that a newly linked fader doesn't move the others
+			for (int trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
+				oldFaders[trkOrGrp] = paFade[trkOrGrp].getValue();
+			}
+			linkBitMaskSeen = linkBitMask;
+		}
+		else if (linkBitMask.any()) {
+			for (int trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
+				if (isLinked(trkOrGrp)) {
+					processLinked(trkOrGrp, paFade[trkOrGrp].getValue());
+				}
+			}
+		}
+	}
+	
+	// called once per light refresh period
+	void updateEcoMask(float costNs, float _sampleTime) {
+		if (ecoAdaptive == 0) {
+			ecoMask = ecoMode & 0x3;
+			return;
+		}
+		// the divider goes up when the cost is over the budget, and down when it is under half of it (a halved divider 
+		// at most doubles the cost), then holds for a while so that the cost of the new divider can be measured. 
+		// Only the control rate gets slower with the divider, so a step up that doesn't save a good part of the cost 
+		// at divider 1 (the audio path is most of it, as when the tracks are dormant) is undone, and not tried again for a longer while.
+		// The cost of a divider is the lowest one measured while it is held, since preemption of the audio thread only adds to it
+		if (ecoSettle > 0) {
+			ecoSettle--;
+		}
+		else {
+			ecoMinNs = std::min(ecoMinNs, costNs);
+		}
+		if (ecoHold > 0) {
+			ecoHold--;
+			return;
+		}
+		int level = ecoLevel();
+		ecoCosts[level] = ecoMinNs;
+		ecoMinNs = INFINITY;
+		ecoHold = GlobalConst::ecoAdaptiveHold;
+		float budgetNs = _sampleTime * 1e9f * (float)ecoBudget * 0.01f;
+		if (level > 0 && ecoCosts[level - 1] - ecoCosts[level] < ecoCosts[0] * GlobalConst::ecoAdaptiveMinSaving) {
+			ecoMask >>= 1;
+			ecoHold = GlobalConst::ecoAdaptiveRetryHold;
+		}
+		else if (ecoCosts[level] > budgetNs && level < 4) {
+			ecoMask = (ecoMask << 1) | 0x1;
+		}
+		else if (ecoCosts[level] < budgetNs * 0.5f && level > 0) {
+			ecoMask >>= 1;
+		}
+		else {
+			return;
+		}
+		ecoSettle = GlobalConst::ecoAdaptiveSettle;
+	}
+	int ecoLevel() {// log2 of the control-rate divider
+		int level = 0;
+		for (uint16_t m = ecoMask; m != 0; m >>= 1) {
+			level++;
+		}
+		return level;
+	}
+	
 	GlobalInfo(Param *_params, float* _values20) {
 		paMute = &_params[TRACK_MUTE_PARAMS];
 		paSolo = &_params[TRACK_SOLO_PARAMS];
@@ -183,24 +307,44 @@ struct GlobalInfo {
 		colorAndCloak.cc4[detailsShow] = 0x7;
 		symmetricalFade = false;
 		fadeCvOutsWithVolCv = false;
-		linkBitMask = 0;
+		linkBitMask.reset();
 		filterPos = 1;// default is post-insert
 		groupedAuxReturnFeedbackProtection = 1;// protection is on by default
 		ecoMode = 0xFFFF;// all 1's means yes, 0 means no
 		masterFaderScalesSends = 0;// false by default
 		polySpreadVandP = 0;
+		ecoAdaptive = 0;
+		ecoBudget = 2;
 		resetNonJson();
 	}
 
 
+	void onSampleRateChange() {
+		sampleTime = APP->engine->getSampleTime();
+		dormantDelaySamples = GlobalConst::dormantDelay / sampleTime;
+	}
+
+
 	void resetNonJson() {
 		updateSoloBitMask();
 		updateReturnSoloBits();
-		sampleTime = APP->engine->getSampleTime();
+		onSampleRateChange();
 		for (int trkOrGrp = 0; trkOrGrp < (N_TRK + N_GRP); trkOrGrp++) {
 			oldFaders[trkOrGrp] = paFade[trkOrGrp].getValue();
 		}			
+		linkBitMaskSeen = linkBitMask;
+		for (int gu = 0; gu < (N_GRP + 1); gu++) {
+			groupUsage[gu] = 0;
+		}
 		updateGroupUsage();
+		setAllSlowDirty();
+		ecoMask = ecoMode & 0x3;// adaptive eco also starts from there
+		ecoHold = GlobalConst::ecoAdaptiveHold;
+		ecoSettle = GlobalConst::ecoAdaptiveSettle;
+		ecoMinNs = INFINITY;
+		for (int i = 0; i < 5; i++) {
+			ecoCosts[i] = 0.0f;
+		}
 	}
 
 
@@ -241,8 +385,12 @@ struct GlobalInfo {
 		// fadeCvOutsWithVolCv
 		json_object_set_new(rootJ, "fadeCvOutsWithVolCv", json_boolean(fadeCvOutsWithVolCv));
 		
-		// linkBitMask
-		json_object_set_new(rootJ, "linkBitMask", json_integer(linkBitMask));
+		// linkBitMask (older versions only read the packed one, which is also written when the groups fit after the tracks)
+		json_object_set_new(rootJ, "linkBitMaskTrk", json_integer(linkBitMask.trk));
+		json_object_set_new(rootJ, "linkBitMaskGrp", json_integer(linkBitMask.grp));
+		if (N_TRK + N_GRP <= 64) {
+			json_object_set_new(rootJ, "linkBitMask", json_integer(linkBitMask.trk | shiftLeft64(linkBitMask.grp, N_TRK)));
+		}
 
 		// filterPos
 		json_object_set_new(rootJ, "filterPos", json_integer(filterPos));
@@ -264,6 +412,12 @@ struct GlobalInfo {
 
 		// linearVolCvInputs
 		json_object_set_new(rootJ, "linearVolCvInputs", json_integer(directOutPanStereoMomentCvLinearVol.cc4[3]));
+
+		// ecoAdaptive
+		json_object_set_new(rootJ, "ecoAdaptive", json_integer(ecoAdaptive));
+
+		// ecoBudget
+		json_object_set_new(rootJ, "ecoBudget", json_integer(ecoBudget));
 	}
 
 
@@ -331,21 +485,29 @@ struct GlobalInfo {
 			fadeCvOutsWithVolCv = json_is_true(fadeCvOutsWithVolCvJ);
 
 		// linkBitMask
+		json_t *linkBitMaskTrkJ = json_object_get(rootJ, "linkBitMaskTrk");
+		json_t *linkBitMaskGrpJ = json_object_get(rootJ, "linkBitMaskGrp");
 		json_t *linkBitMaskJ = json_object_get(rootJ, "linkBitMask");
-		if (linkBitMaskJ) {
-			unsigned long newLinkBitMask = json_integer_value(linkBitMaskJ);
+		if ((linkBitMaskTrkJ && linkBitMaskGrpJ) || linkBitMaskJ) {
+			TrkGrpBits newLinkBitMask;
+			if (linkBitMaskTrkJ && linkBitMaskGrpJ) {
+				newLinkBitMask.trk = json_integer_value(linkBitMaskTrkJ);
+				newLinkBitMask.grp = json_integer_value(linkBitMaskGrpJ);
+			}
+			else {// older versions: groups packed after the tracks
+				uint64_t packedBitMask = json_integer_value(linkBitMaskJ);
+				newLinkBitMask.trk = packedBitMask & lowBits64(nTrkSrc);
+				newLinkBitMask.grp = shiftRight64(packedBitMask, nTrkSrc) & lowBits64(nGrpSrc);
+			}
 			if (N_TRK == nTrkSrc) {
 				linkBitMask = newLinkBitMask;
 			}
 			else {
-				// code below assumes when 8 track mixer has 2 groups and 16 track mixer has 4 groups
-				if (N_TRK == 8) {// nTrkSrc is automatically 16, so moving from 16 down to 8
-					linkBitMask = ( (newLinkBitMask & 0xFF) | ((newLinkBitMask & 0x30000) >> 8) );
-				}
-				else {// nTrkSrc is automatically 8, so moving from 8 up to 16
-					linkBitMask &= 0xCFF00;// kill bits in sr that correspond to jr's bits
-					linkBitMask |= ( (newLinkBitMask & 0xFF) | ((newLinkBitMask & 0x300) << 8) );
-				}
+				// the tracks and groups that both mixers have are copied, the others keep their links
+				uint64_t trkBits = lowBits64(std::min(N_TRK, nTrkSrc));
+				uint64_t grpBits = lowBits64(std::min(N_GRP, nGrpSrc));
+				linkBitMask.trk = (linkBitMask.trk & ~trkBits) | (newLinkBitMask.trk & trkBits);
+				linkBitMask.grp = (linkBitMask.grp & ~grpBits) | (newLinkBitMask.grp & grpBits);
 			}
 		}
 		
@@ -386,6 +548,16 @@ struct GlobalInfo {
 		if (linearVolCvInputsJ)
 			directOutPanStereoMomentCvLinearVol.cc4[3] = json_integer_value(linearVolCvInputsJ);
 		
+		// ecoAdaptive
+		json_t *ecoAdaptiveJ = json_object_get(rootJ, "ecoAdaptive");
+		if (ecoAdaptiveJ)
+			ecoAdaptive = json_integer_value(ecoAdaptiveJ);
+		
+		// ecoBudget
+		json_t *ecoBudgetJ = json_object_get(rootJ, "ecoBudget");
+		if (ecoBudgetJ)
+			ecoBudget = json_integer_value(ecoBudgetJ);
+		
 		// extern must call resetNonJson()
 	}	
 		
@@ -596,6 +768,45 @@ struct MixerMaster {
 		
 		// extern must call resetNonJson()
 	}			
+
+
+	void dataToBlob(SettingsBlob* blob) {// same fields as dataToJson()
+		blob->beginRecord();
+		blob->put(dcBlock);
+		blob->put(clipping);
+		blob->put(fadeRate);
+		blob->put(fadeProfile);
+		blob->put(vuColorThemeLocal);
+		blob->put(dispColorLocal);
+		blob->put(momentCvMuteLocal);
+		blob->put(momentCvDimLocal);
+		blob->put(momentCvMonoLocal);
+		blob->put(chainOnly);
+		blob->put(dimGain);
+		blob->putBytes(masterLabel, 7);
+		blob->endRecord();
+	}
+
+
+	void dataFromBlob(SettingsBlob* blob) {
+		if (blob->openRecord()) {
+			blob->get(&dcBlock);
+			blob->get(&clipping);
+			blob->get(&fadeRate);
+			blob->get(&fadeProfile);
+			blob->get(&vuColorThemeLocal);
+			blob->get(&dispColorLocal);
+			blob->get(&momentCvMuteLocal);
+			blob->get(&momentCvDimLocal);
+			blob->get(&momentCvMonoLocal);
+			blob->get(&chainOnly);
+			blob->get(&dimGain);
+			blob->getBytes(masterLabel, 7);
+			masterLabel[6] = 0;
+		}
+		blob->closeRecord();
+		// extern must call resetNonJson()
+	}
 	
 	void setupDcBlocker() {
 		float fc = 10.0f;// Hz
@@ -650,6 +861,11 @@ struct MixerMaster {
 	}
 
 
+	// the chain cables are marked by onPortChange(), this is the check of MixMaster::sweepSlowChanged()
+	bool isSlowChanged() {
+		return (inChain[0].isConnected() ? 1.0f : 0.0f) != chainGainsAndMute[0] || (inChain[1].isConnected() ? 1.0f : 0.0f) != chainGainsAndMute[1];
+	}
+
 	void updateSlowValues() {		
 		// calc ** chainGains **
 		chainGainsAndMute[0] = inChain[0].isConnected() ? 1.0f : 0.0f;
@@ -675,9 +891,9 @@ struct MixerMaster {
 			}
 			if (fadeGain != target) {
 				if (isFadeMode()) {
-					float deltaX = (gInfo->sampleTime / fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
+					float deltaX = (gInfo->sampleTime / fadeRate) * (1 + gInfo->ecoMask);// last value is sub refresh
 					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::masterFaderScalingExponent);
+					fadeGainScaled = powInt(fadeGain, GlobalConst::masterFaderScalingExponent);
 				}
 				else {// we are in mute mode
 					fadeGain = target;
@@ -706,7 +922,7 @@ struct MixerMaster {
 			}
 
 			// scaling
-			fader = std::pow(fader, GlobalConst::masterFaderScalingExponent);
+			fader = powInt(fader, GlobalConst::masterFaderScalingExponent);
 			
 			// calc ** gainMatrix **
 			// mono
@@ -752,8 +968,7 @@ struct MixerMaster {
 		
 		// VUs (no cloaked mode for master, always on)
 		if (eco) {
-			float sampleTimeEco = gInfo->sampleTime * (1 + (gInfo->ecoMode & 0x3));
-			vu.process(sampleTimeEco, fadeGainScaled == 0.0f ? &sigs[0] : mix);
+			gInfo->vuBank.add(&vu, fadeGainScaled == 0.0f ? &sigs[0] : mix);
 		}
 				
 		// Chain inputs when post master
@@ -811,8 +1026,6 @@ struct MixerGroup {
 	SlewLimiterSingle stereoWidthSlewer;
 	SlewLimiterSingle muteSoloGainSlewer;
 	private:
-	ButterworthThirdOrder hpFilter[2];// 18dB/oct
-	ButterworthSecondOrder lpFilter[2];// 12db/oct
 	float lastHpfCutoff;
 	float lastLpfCutoff;
 	simd::float_4 panMatrix;
@@ -846,13 +1059,14 @@ struct MixerGroup {
 	Param *paLpfCutoff;
 	float *taps;// [0],[1]: pre-insert L R; [32][33]: pre-fader L R, [64][65]: post-fader L R, [96][97]: post-mute-solo L R
 	float *insertOuts;// [0][1]: insert outs for this group
+	MixerFilterBank *filterBank;// holds the HPF and LPF of this group
 
 
 	float calcFadeGain() {return paMute->getValue() >= 0.5f ? 0.0f : 1.0f;}
 	bool isFadeMode() {return *fadeRate >= GlobalConst::minFadeRate;}
 
 
-	MixerGroup(int _groupNum, GlobalInfo *_gInfo, Input *_inputs, Param *_params, char* _groupName, float* _taps, float* _insertOuts) {
+	MixerGroup(int _groupNum, GlobalInfo *_gInfo, Input *_inputs, Param *_params, char* _groupName, float* _taps, float* _insertOuts, MixerFilterBank *_filterBank) {
 		groupNum = _groupNum;
 		ids = "id_g" + std::to_string(groupNum) + "_";
 		gInfo = _gInfo;
@@ -868,16 +1082,13 @@ struct MixerGroup {
 		groupName = _groupName;
 		taps = _taps;
 		insertOuts = _insertOuts;
+		filterBank = _filterBank;
 		
 		fadeRate = &(_gInfo->fadeRates[N_TRK + groupNum]);
 		gainMatrixSlewers.setRiseFall(simd::float_4(GlobalConst::antipopSlewSlow)); // slew rate is in input-units per second (ex: V/s)
 		gainAdjustSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
 		stereoWidthSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
 		muteSoloGainSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
-		for (int i = 0; i < 2; i++) {
-			hpFilter[i].setParameters(true, 0.1f);
-			lpFilter[i].setParameters(false, 0.4f);
-		}
 		
 		onReset();
 	}
@@ -907,10 +1118,7 @@ struct MixerGroup {
 		gainAdjustSlewer.reset();
 		stereoWidthSlewer.reset();
 		muteSoloGainSlewer.reset();
-		for (int i = 0; i < 2; i++) {
-			hpFilter[i].reset();
-			lpFilter[i].reset();
-		}
+		filterBank->resetChannel(N_TRK + groupNum);
 		// lastHpfCutoff; automatically set in setHPFCutoffFreq()
 		// lastLpfCutoff; automatically set in setLPFCutoffFreq()
 		setHPFCutoffFreq(paHpfCutoff->getValue());// off
@@ -1049,12 +1257,51 @@ struct MixerGroup {
 		// extern must call resetNonJson()
 	}	
 
+
+	void dataToBlob(SettingsBlob* blob) {// same fields as dataToJson()
+		blob->beginRecord();
+		blob->put(gainAdjust);
+		blob->put(*fadeRate);
+		blob->put(fadeProfile);
+		blob->put(directOutsMode);
+		blob->put(auxSendsMode);
+		blob->put(panLawStereo);
+		blob->put(vuColorThemeLocal);
+		blob->put(filterPos);
+		blob->put(dispColorLocal);
+		blob->put(momentCvMuteLocal);
+		blob->put(momentCvSoloLocal);
+		blob->put(panCvLevel);
+		blob->put(stereoWidth);
+		blob->endRecord();
+	}
+
+
+	void dataFromBlob(SettingsBlob* blob) {
+		if (blob->openRecord()) {
+			blob->get(&gainAdjust);
+			blob->get(fadeRate);
+			blob->get(&fadeProfile);
+			blob->get(&directOutsMode);
+			blob->get(&auxSendsMode);
+			blob->get(&panLawStereo);
+			blob->get(&vuColorThemeLocal);
+			blob->get(&filterPos);
+			blob->get(&dispColorLocal);
+			blob->get(&momentCvMuteLocal);
+			blob->get(&momentCvSoloLocal);
+			blob->get(&panCvLevel);
+			blob->get(&stereoWidth);
+		}
+		blob->closeRecord();
+		// extern must call resetNonJson()
+	}
+
 	void setHPFCutoffFreq(float fc) {
 		paHpfCutoff->setValue(fc);
 		lastHpfCutoff = fc;
 		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
-		hpFilter[0].setParameters(true, fc);
-		hpFilter[1].setParameters(true, fc);
+		filterBank->setHpfCutoff(N_TRK + groupNum, fc);
 	}
 	float getHPFCutoffFreq() {return paHpfCutoff->getValue();}
 	
@@ -1062,8 +1309,7 @@ struct MixerGroup {
 		paLpfCutoff->setValue(fc);
 		lastLpfCutoff = fc;
 		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
-		lpFilter[0].setParameters(false, fc);
-		lpFilter[1].setParameters(false, fc);
+		filterBank->setLpfCutoff(N_TRK + groupNum, fc);
 	}
 	float getLPFCutoffFreq() {return paLpfCutoff->getValue();}
 
@@ -1074,6 +1320,11 @@ struct MixerGroup {
 	}
 
 	
+	// the filter knobs are marked by their param quantities, this is the check of MixMaster::sweepSlowChanged()
+	bool isSlowChanged() {
+		return paHpfCutoff->getValue() != lastHpfCutoff || paLpfCutoff->getValue() != lastLpfCutoff;
+	}
+
 	void updateSlowValues() {
 		// filters
 		if (paHpfCutoff->getValue() != lastHpfCutoff) {
@@ -1082,9 +1333,6 @@ struct MixerGroup {
 		if (paLpfCutoff->getValue() != lastLpfCutoff) {
 			setLPFCutoffFreq(paLpfCutoff->getValue());
 		}
-
-		// ** process linked **
-		gInfo->processLinked(N_TRK + groupNum, paFade->getValue());
 		
 		// ** detect pan mode change ** (and trigger recalc of panMatrix)
 		PackedBytes4 newPanSig;
@@ -1099,7 +1347,13 @@ struct MixerGroup {
 	}
 	
 
-	void process(float *mix, bool eco) {// group
+	bool isFilterPostInsert() {
+		return gInfo->filterPos == 1 || (gInfo->filterPos == 2 && filterPos == 1);
+	}
+
+
+	// stereo width and gain adjust, and setup of this group's channel in the filter bank
+	void processPreInsert() {
 		// Tap[0],[1]: pre-insert (group inputs)
 		// already set up by the mix master, so only stereo width to apply
 		
@@ -1120,62 +1374,32 @@ struct MixerGroup {
 			taps[1] *= gainAdjustSlewer.out;
 		}
 		
-		// Tap[8],[9]: pre-fader (inserts and filters)
-		// NEW VERSION
-		if (gInfo->filterPos == 1 || (gInfo->filterPos == 2 && filterPos == 1)) {// if filters post insert
-			// Insert outputs
+		filterBank->setChannel(N_TRK + groupNum, getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq, getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq, true, !isFilterPostInsert());
+	}
+	
+	
+	// inserts, reads tap[8],[9] and writes them and the insert outs
+	// the mix master has already copied tap[0],[1] into tap[8],[9] and done the filters when they are pre-insert
+	void processInserts() {
+		// Insert outputs
+		if (isFilterPostInsert()) {
 			insertOuts[0] = taps[0];
 			insertOuts[1] = taps[1];
-			
-			// Insert inputs
-			if (inInsert->isConnected()) {
-				taps[N_GRP * 2 + 0] = clampNothing(inInsert->getVoltage((groupNum << 1) + 0));
-				taps[N_GRP * 2 + 1] = clampNothing(inInsert->getVoltage((groupNum << 1) + 1));
-			}
-			else {
-				taps[N_GRP * 2 + 0] = taps[0];
-				taps[N_GRP * 2 + 1] = taps[1];
-			}
-
-			// Filters
-			// HPF
-			if (getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq) {
-				taps[N_GRP * 2 + 0] = hpFilter[0].process(taps[N_GRP * 2 + 0]);
-				taps[N_GRP * 2 + 1] = hpFilter[1].process(taps[N_GRP * 2 + 1]);
-			}
-			// LPF
-			if (getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq) {
-				taps[N_GRP * 2 + 0] = lpFilter[0].process(taps[N_GRP * 2 + 0]);
-				taps[N_GRP * 2 + 1] = lpFilter[1].process(taps[N_GRP * 2 + 1]);
-			}
 		}
-		else {// filters before inserts
-			taps[N_GRP * 2 + 0] = taps[0];
-			taps[N_GRP * 2 + 1] = taps[1];
-			// Filters
-			// HPF
-			if (getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq) {
-				taps[N_GRP * 2 + 0] = hpFilter[0].process(taps[N_GRP * 2 + 0]);
-				taps[N_GRP * 2 + 1] = hpFilter[1].process(taps[N_GRP * 2 + 1]);
-			}
-			// LPF
-			if (getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq) {
-				taps[N_GRP * 2 + 0] = lpFilter[0].process(taps[N_GRP * 2 + 0]);
-				taps[N_GRP * 2 + 1] = lpFilter[1].process(taps[N_GRP * 2 + 1]);
-			}
-			
-			// Insert outputs
+		else {
 			insertOuts[0] = taps[N_GRP * 2 + 0];
 			insertOuts[1] = taps[N_GRP * 2 + 1];
-			
-			// Insert inputs
-			if (inInsert->isConnected()) {
-				taps[N_GRP * 2 + 0] = clampNothing(inInsert->getVoltage((groupNum << 1) + 0));
-				taps[N_GRP * 2 + 1] = clampNothing(inInsert->getVoltage((groupNum << 1) + 1));
-			}
-		}// filterPos
-
+		}
+		
+		// Insert inputs
+		if (inInsert->isConnected()) {
+			taps[N_GRP * 2 + 0] = clampNothing(inInsert->getVoltage((groupNum << 1) + 0));
+			taps[N_GRP * 2 + 1] = clampNothing(inInsert->getVoltage((groupNum << 1) + 1));
+		}
+	}
+	
 
+	void process(float *mix, bool eco) {// group, after processPreInsert(), the filters and processInserts()
 		if (eco) {	
 			// calc ** fadeGain, fadeGainX, fadeGainXr, target, fadeGainScaled **
 			float newTarget = calcFadeGain();
@@ -1189,9 +1413,9 @@ struct MixerGroup {
 			}
 			if (fadeGain != target) {
 				if (isFadeMode()) {
-					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
+					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + gInfo->ecoMask);// last value is sub refresh
 					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
+					fadeGainScaled = powInt(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
 				}
 				else {// we are in mute mode
 					fadeGain = target;
@@ -1258,7 +1482,7 @@ struct MixerGroup {
 				oldPan = pan;
 			}
 			// calc ** gainMatrix **
-			fader = std::pow(fader, GlobalConst::trkAndGrpFaderScalingExponent);// scaling
+			fader = powInt(fader, GlobalConst::trkAndGrpFaderScalingExponent);// scaling
 			gainMatrix = panMatrix * fader;
 		}
 	
@@ -1292,8 +1516,7 @@ struct MixerGroup {
 			vu.reset();
 		}
 		else if (eco) {
-			float sampleTimeEco = gInfo->sampleTime * (1 + (gInfo->ecoMode & 0x3));
-			vu.process(sampleTimeEco, &taps[N_GRP * (fadeGainScaled == 0.0f ? 4 : 6) + 0]);
+			gInfo->vuBank.add(&vu, &taps[N_GRP * (fadeGainScaled == 0.0f ? 4 : 6) + 0]);
 		}
 	}
 };// struct MixerGroup
@@ -1330,20 +1553,16 @@ struct MixerTrack {
 
 	// no need to save, with reset
 	bool stereo;// pan coefficients use this, so set up first
+	float inGain;// target of the in gain slewer in the track bank
+	simd::float_4 gainMatrix;// target of the gain matrix slewers in the track bank
+	bool bankResetRequest;// track bank resets this track's lane of slewers when set
 	private:
-	float inGain;
 	simd::float_4 panMatrix;
-	simd::float_4 gainMatrix;	
-	TSlewLimiterSingle<simd::float_4> gainMatrixSlewers;
-	SlewLimiterSingle inGainSlewer;
-	SlewLimiterSingle stereoWidthSlewer;
-	SlewLimiterSingle muteSoloGainSlewer;
-	ButterworthThirdOrder hpFilter[2];// 18dB/oct
-	ButterworthSecondOrder lpFilter[2];// 12db/oct
 	float lastHpfCutoff;
 	float lastLpfCutoff;
 	float oldPan;
 	PackedBytes4 oldPanSignature;// [0] is pan stereo local, [1] is pan stereo global, [2] is pan mono global
+	PackedBytes4 oldInSigSignature;// [0] is left connected, [1] is right connected, [2] is left polyphonic
 	public:
 	VuMeterAllDual vu;
 	float fadeGain; // target of this gain is the value of the mute/fade button's param (i.e. 0.0f or 1.0f)
@@ -1378,6 +1597,7 @@ struct MixerTrack {
 	float *taps;// [0],[1]: pre-insert L R; [32][33]: pre-fader L R, [64][65]: post-fader L R, [96][97]: post-mute-solo L R
 	float* groupTaps;// [0..1] tap 0 of group 1, [1..2] tap 0 of group 2, etc.
 	float *insertOuts;// [0][1]: insert outs for this track
+	MixerFilterBank *filterBank;// holds the HPF and LPF of this track
 	bool oldInUse = true;
 	float fader = 0.0f;// this is set only in process() when eco, and also used only when eco in another section of this method
 
@@ -1386,7 +1606,7 @@ struct MixerTrack {
 	bool isFadeMode() {return *fadeRate >= GlobalConst::minFadeRate;}
 
 
-	MixerTrack(int _trackNum, GlobalInfo *_gInfo, Input *_inputs, Param *_params, char* _trackName, float* _taps, float* _groupTaps, float* _insertOuts) {
+	MixerTrack(int _trackNum, GlobalInfo *_gInfo, Input *_inputs, Param *_params, char* _trackName, float* _taps, float* _groupTaps, float* _insertOuts, MixerFilterBank *_filterBank) {
 		trackNum = _trackNum;
 		ids = "id_t" + std::to_string(trackNum) + "_";
 		gInfo = _gInfo;
@@ -1407,16 +1627,9 @@ struct MixerTrack {
 		taps = _taps;
 		groupTaps = _groupTaps;
 		insertOuts = _insertOuts;
+		filterBank = _filterBank;
 		
 		fadeRate = &(_gInfo->fadeRates[trackNum]);
-		gainMatrixSlewers.setRiseFall(simd::float_4(GlobalConst::antipopSlewSlow)); // slew rate is in input-units per second (ex: V/s)
-		inGainSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
-		stereoWidthSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
-		muteSoloGainSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
-		for (int i = 0; i < 2; i++) {
-			hpFilter[i].setParameters(true, 0.1f);
-			lpFilter[i].setParameters(false, 0.4f);
-		}
 		
 		onReset();
 	}
@@ -1448,20 +1661,15 @@ struct MixerTrack {
 		inGain = 0.0f;
 		panMatrix = 0.0f;
 		gainMatrix = 0.0f;
-		gainMatrixSlewers.reset();
-		inGainSlewer.reset();
-		stereoWidthSlewer.reset();
-		muteSoloGainSlewer.reset(); 
-		for (int i = 0; i < 2; i++) {
-			hpFilter[i].reset();
-			lpFilter[i].reset();
-		}
+		bankResetRequest = true;
+		filterBank->resetChannel(trackNum);
 		// lastHpfCutoff; automatically set in setHPFCutoffFreq()
 		// lastLpfCutoff; automatically set in setLPFCutoffFreq()
 		setHPFCutoffFreq(paHpfCutoff->getValue());// off
 		setLPFCutoffFreq(paLpfCutoff->getValue());// off
 		oldPan = -10.0f;
 		oldPanSignature.cc1 = 0xFFFFFFFF;
+		oldInSigSignature.cc1 = 0xFFFFFFFF;
 		vu.reset();
 		fadeGain = calcFadeGain();
 		target = fadeGain;
@@ -1474,6 +1682,7 @@ struct MixerTrack {
 		panCvConnected = false;
 		volCv = 1.0f;
 		soloGain = 1.0f;
+		gInfo->requestSlowDirty(trackNum);// stereo and inGain above
 	}
 
 
@@ -1621,6 +1830,50 @@ struct MixerTrack {
 	}
 
 
+	void dataToBlob(SettingsBlob* blob) {// same fields as dataToJson()
+		blob->beginRecord();
+		blob->put(gainAdjust);
+		blob->put(*fadeRate);
+		blob->put(fadeProfile);
+		blob->put(directOutsMode);
+		blob->put(auxSendsMode);
+		blob->put(panLawStereo);
+		blob->put(vuColorThemeLocal);
+		blob->put(filterPos);
+		blob->put(dispColorLocal);
+		blob->put(momentCvMuteLocal);
+		blob->put(momentCvSoloLocal);
+		blob->put(polyStereo);
+		blob->put(panCvLevel);
+		blob->put(stereoWidth);
+		blob->put(invertInput);
+		blob->endRecord();
+	}
+
+
+	void dataFromBlob(SettingsBlob* blob) {
+		if (blob->openRecord()) {
+			blob->get(&gainAdjust);
+			blob->get(fadeRate);
+			blob->get(&fadeProfile);
+			blob->get(&directOutsMode);
+			blob->get(&auxSendsMode);
+			blob->get(&panLawStereo);
+			blob->get(&vuColorThemeLocal);
+			blob->get(&filterPos);
+			blob->get(&dispColorLocal);
+			blob->get(&momentCvMuteLocal);
+			blob->get(&momentCvSoloLocal);
+			blob->get(&polyStereo);
+			blob->get(&panCvLevel);
+			blob->get(&stereoWidth);
+			blob->get(&invertInput);
+		}
+		blob->closeRecord();
+		// extern must call resetNonJson()
+	}
+
+
 	// level 1 read and write
 	void write(TrackSettingsCpBuffer *dest) {
 		dest->gainAdjust = gainAdjust;
@@ -1640,7 +1893,7 @@ struct MixerTrack {
 		dest->panCvLevel = panCvLevel;
 		dest->stereoWidth = stereoWidth;
 		dest->invertInput = invertInput;
-		dest->linkedFader = isLinked(&(gInfo->linkBitMask), trackNum);
+		dest->linkedFader = gInfo->isLinked(trackNum);
 	}
 	void read(const TrackSettingsCpBuffer *src) {
 		gainAdjust = src->gainAdjust;
@@ -1661,6 +1914,7 @@ struct MixerTrack {
 		stereoWidth = src->stereoWidth;
 		invertInput = src->invertInput;
 		gInfo->setLinked(trackNum, src->linkedFader);
+		gInfo->requestSlowDirty(trackNum);// inGain, stereo and pan law above
 	}
 
 
@@ -1703,8 +1957,7 @@ struct MixerTrack {
 		paHpfCutoff->setValue(fc);
 		lastHpfCutoff = fc;
 		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
-		hpFilter[0].setParameters(true, fc);
-		hpFilter[1].setParameters(true, fc);
+		filterBank->setHpfCutoff(trackNum, fc);
 	}
 	float getHPFCutoffFreq() {return paHpfCutoff->getValue();}
 	
@@ -1712,28 +1965,27 @@ struct MixerTrack {
 		paLpfCutoff->setValue(fc);
 		lastLpfCutoff = fc;
 		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
-		lpFilter[0].setParameters(false, fc);
-		lpFilter[1].setParameters(false, fc);
+		filterBank->setLpfCutoff(trackNum, fc);
 	}
 	float getLPFCutoffFreq() {return paLpfCutoff->getValue();}
 
 	float calcSoloGain() {// returns 1.0f when the check for solo means this track should play, 0.0f otherwise
-		if (gInfo->soloBitMask == 0ul) {// no track nor groups are soloed 
+		if (!gInfo->soloBitMask.any()) {// no track nor groups are soloed 
 			return 1.0f;
 		}
 		// here at least one track or group is soloed
 		int group = (int)(paGroup->getValue() + 0.5f);
-		if ( ((gInfo->soloBitMask & (1 << trackNum)) != 0) ) {// if this track is soloed
-			if (group == 0 || ((gInfo->soloBitMask & ((N_GRP * N_GRP - 1) << N_TRK)) == 0)) {// not grouped, or grouped but no groups are soloed, play
+		if ( ((gInfo->soloBitMask.trk & ((uint64_t)1 << trackNum)) != 0) ) {// if this track is soloed
+			if (group == 0 || gInfo->soloBitMask.grp == 0) {// not grouped, or grouped but no groups are soloed, play
 				return 1.0f;
 			}
 			// grouped and at least one group is soloed, so play only if its group is itself soloed
-			return ( (gInfo->soloBitMask & (1ul << (N_TRK + group - 1))) != 0ul ? 1.0f : 0.0f);
+			return ( (gInfo->soloBitMask.grp & ((uint64_t)1 << (group - 1))) != 0 ? 1.0f : 0.0f);
 		}
 		// here this track is not soloed
-		if ( (group != 0) && ( (gInfo->soloBitMask & (1ul << (N_TRK + group - 1))) != 0ul ) ) {// if going through soloed group  
+		if ( (group != 0) && ( (gInfo->soloBitMask.grp & ((uint64_t)1 << (group - 1))) != 0 ) ) {// if going through soloed group  
 			// check all solos of all tracks mapped to group, and return true if all those solos are off
-			return ((gInfo->groupUsage[group - 1] & gInfo->soloBitMask) == 0) ? 1.0f : 0.0f;
+			return ((gInfo->groupUsage[group - 1] & gInfo->soloBitMask.trk) == 0) ? 1.0f : 0.0f;
 		}
 		return 0.0f;
 	}
@@ -1745,6 +1997,21 @@ struct MixerTrack {
 	}
 
 	
+	PackedBytes4 calcInSigSignature() {
+		PackedBytes4 newInSigSig;
+		newInSigSig.cc4[0] = inSig[0].isConnected() ? 1 : 0;
+		newInSigSig.cc4[1] = inSig[1].isConnected() ? 1 : 0;
+		newInSigSig.cc4[2] = inSig[0].isPolyphonic() ? 1 : 0;
+		newInSigSig.cc4[3] = 0;
+		return newInSigSig;
+	}
+
+	// the filter knobs and the input cables are marked by their param quantities and onPortChange(), and everything else that
+	// updateSlowValues() depends on is marked where it changes; this is the check of MixMaster::sweepSlowChanged()
+	bool isSlowChanged() {
+		return paHpfCutoff->getValue() != lastHpfCutoff || paLpfCutoff->getValue() != lastLpfCutoff || calcInSigSignature().cc1 != oldInSigSignature.cc1;
+	}
+
 	void updateSlowValues() {
 		// filters
 		if (paHpfCutoff->getValue() != lastHpfCutoff) {
@@ -1753,6 +2020,7 @@ struct MixerTrack {
 		if (paLpfCutoff->getValue() != lastLpfCutoff) {
 			setLPFCutoffFreq(paLpfCutoff->getValue());
 		}
+		oldInSigSignature = calcInSigSignature();
 		
 		// calc ** stereo **
 		bool newStereo = (inSig[0].isConnected() && inSig[1].isConnected()) || (polyStereo != 0 && inSig[0].isPolyphonic());
@@ -1780,36 +2048,37 @@ struct MixerTrack {
 		
 		// soloGain
 		soloGain = calcSoloGain();
-
-		// ** process linked **
-		gInfo->processLinked(trackNum, paFade->getValue());
 	}
 	
 
-	void process(float *mix, bool eco) {// track		
-		if (eco) {
-			// calc ** fadeGain, fadeGainX, fadeGainXr, target, fadeGainScaled **
-			float newTarget = calcFadeGain();
-			if (newTarget != target) {
-				fadeGainXr = 0.0f;
-				if (isFadeMode()) {
-					gInfo->fadeOtherLinkedTracks(trackNum, newTarget);
-				}
-				target = newTarget;
-				vu.reset();
+	// control-rate part of the track, the audio-rate part is done for all tracks at once in MixerTrackBank::process()
+	// calc ** target **, and ** fadeGain, fadeGainX, fadeGainXr, fadeGainScaled ** when in mute mode
+	// returns true when fadeGain must be moved along its fade curve, which the track bank then does for all fading tracks at once
+	bool processFadeTarget() {// track, only when eco
+		float newTarget = calcFadeGain();
+		if (newTarget != target) {
+			fadeGainXr = 0.0f;
+			if (isFadeMode()) {
+				gInfo->fadeOtherLinkedTracks(trackNum, newTarget);
 			}
-			if (fadeGain != target) {
-				if (isFadeMode()) {
-					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
-					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
-				}
-				else {// we are in mute mode
-					fadeGain = target;
-					fadeGainX = target;
-					fadeGainScaled = target;// no pow needed here since 0.0f or 1.0f
-				}
+			target = newTarget;
+			vu.reset();
+		}
+		if (fadeGain != target) {
+			if (isFadeMode()) {
+				return true;
 			}
+			// we are in mute mode
+			fadeGain = target;
+			fadeGainX = target;
+			fadeGainScaled = target;// no pow needed here since 0.0f or 1.0f
+		}
+		return false;
+	}
+
+
+	void processControl(bool eco) {// track, after processFadeTarget() and the fades in the track bank
+		if (eco) {
 			fadeGainScaledWithSolo = fadeGainScaled * soloGain;
 
 			// calc ** fader, paramWithCV, volCv **
@@ -1849,130 +2118,7 @@ struct MixerTrack {
 					pan = clamp(pan, 0.0f, 1.0f);
 				}
 			}
-		}
-
 
-		// optimize unused track
-		if (!inSig[0].isConnected()) {
-			if (oldInUse) {
-				taps[0] = 0.0f; taps[1] = 0.0f;
-				taps[N_TRK * 2 + 0] = 0.0f; taps[N_TRK * 2 + 1] = 0.0f;
-				taps[N_TRK * 4 + 0] = 0.0f; taps[N_TRK * 4 + 1] = 0.0f;
-				taps[N_TRK * 6 + 0] = 0.0f; taps[N_TRK * 6 + 1] = 0.0f;
-				insertOuts[0] = 0.0f;
-				insertOuts[1] = 0.0f;
-				vu.reset();
-				gainMatrixSlewers.reset();
-				inGainSlewer.reset();
-				stereoWidthSlewer.reset();
-				muteSoloGainSlewer.reset();
-				oldInUse = false;
-			}
-			return;
-		}
-		oldInUse = true;
-			
-		
-		// Tap[0],[1]: pre-insert (inputs with gain adjust and stereo width)
-		
-		// in Gain
-		if (inGain != inGainSlewer.out) {
-			inGainSlewer.process(gInfo->sampleTime, inGain);
-		}
-		if (stereo) {// either because R is connected, or polyStereo is active and L is a poly cable
-			if (inSig[1].isConnected()) {// if stereo because R connected
-				taps[0] = inSig[0].getVoltageSum();
-				taps[1] = inSig[1].getVoltageSum();
-			}
-			else {// here were are in polyStero mode, so take all odd numbered into L, even numbered into R (1-indexed)
-				taps[0] = 0.0f;
-				taps[1] = 0.0f;
-				for (int c = 0; c < inSig[0].getChannels(); c++) {
-					if ((c & 0x1) == 0) {// if L channels (odd channels when 1-indexed)
-						taps[0] += inSig[0].getVoltage(c);
-					}
-					else {
-						taps[1] += inSig[0].getVoltage(c);
-					}
-				}
-			}
-			taps[0] = clampNothing(taps[0] * inGainSlewer.out);
-			taps[1] = clampNothing(taps[1] * inGainSlewer.out);
-		}
-		else {
-			taps[0] = clampNothing(inSig[0].getVoltageSum() * inGainSlewer.out);
-			taps[1] = taps[0];
-		}
-		
-		// Stereo width
-		if (stereoWidth != stereoWidthSlewer.out) {
-			stereoWidthSlewer.process(gInfo->sampleTime, stereoWidth);
-		}
-		if (stereo && stereoWidthSlewer.out != 1.0f) {
-			applyStereoWidth(stereoWidthSlewer.out, &taps[0], &taps[1]);
-		}
-
-
-		// Tap[32],[33]: pre-fader (inserts and filters)
-		
-		int insertPortIndex = trackNum >> 3;		
-		if (gInfo->filterPos == 1 || (gInfo->filterPos == 2 && filterPos == 1)) {// if filters post insert
-			// Insert outputs
-			insertOuts[0] = taps[0];
-			insertOuts[1] = stereo ? taps[1] : 0.0f;// don't send to R of insert outs when mono
-			
-			// Insert inputs
-			if (inInsert[insertPortIndex].isConnected()) {
-				taps[N_TRK * 2 + 0] = clampNothing(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 0));
-				taps[N_TRK * 2 + 1] = stereo ? clampNothing(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 1)) : taps[N_TRK * 2 + 0];// don't receive from R of insert outs when mono, just normal L into R (need this for aux sends)
-			}
-			else {
-				taps[N_TRK * 2 + 0] = taps[0];
-				taps[N_TRK * 2 + 1] = taps[1];
-			}
-
-			// Filters
-			// HPF
-			if (getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = hpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? hpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-			// LPF
-			if (getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = lpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? lpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-		}
-		else {// filters before inserts
-			taps[N_TRK * 2 + 0] = taps[0];
-			taps[N_TRK * 2 + 1] = taps[1];
-			// Filters
-			// HPF
-			if (getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = hpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? hpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-			// LPF
-			if (getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = lpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? lpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-			
-			// Insert outputs
-			insertOuts[0] = taps[N_TRK * 2 + 0];
-			insertOuts[1] = stereo ? taps[N_TRK * 2 + 1] : 0.0f;// don't send to R of insert outs when mono!
-			
-			// Insert inputs
-			if (inInsert[insertPortIndex].isConnected()) {
-				taps[N_TRK * 2 + 0] = clampNothing(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 0));
-				taps[N_TRK * 2 + 1] = stereo ? clampNothing(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 1)) : taps[N_TRK * 2 + 0];// don't receive from R of insert outs when mono, just normal L into R (need this for aux sends)
-			}
-		}// filterPos
-		
-		
-		// Tap[64],[65]: post-fader (pan and fader)
-		
-		if (eco) {
 			// calc ** panMatrix **
 			if (pan != oldPan) {
 				panMatrix = 0.0f;// L, R, RinL, LinR (used for fader-pan block)
@@ -2033,49 +2179,35 @@ struct MixerTrack {
 				oldPan = pan;
 			}
 			// calc ** gainMatrix **
-			fader = std::pow(fader, GlobalConst::trkAndGrpFaderScalingExponent);// scaling
+			fader = powInt(fader, GlobalConst::trkAndGrpFaderScalingExponent);// scaling
 			gainMatrix = panMatrix * fader;
 		}
-		
-		// Apply gainMatrix
-		simd::float_4 sigs(taps[N_TRK * 2 + 0], taps[N_TRK * 2 + 1], taps[N_TRK * 2 + 1], taps[N_TRK * 2 + 0]);// L, R, RinL, LinR
-		if (movemask(gainMatrix == gainMatrixSlewers.out) != 0xF) {// movemask returns 0xF when 4 floats are equal
-			gainMatrixSlewers.process(gInfo->sampleTime, gainMatrix);
-		}
-		sigs *= gainMatrixSlewers.out;
-		taps[N_TRK * 4 + 0] = sigs[0] + sigs[2];
-		taps[N_TRK * 4 + 1] = sigs[1] + sigs[3];
-		if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[3] != 0) {
-			taps[N_TRK * 4 + 0] *= volCv;
-			taps[N_TRK * 4 + 1] *= volCv;
-		}
+	}
+	
+	
+	bool isFilterPostInsert() {
+		return gInfo->filterPos == 1 || (gInfo->filterPos == 2 && filterPos == 1);
+	}
 
-		// Calc muteSoloGainSlewed
-		if (fadeGainScaledWithSolo != muteSoloGainSlewer.out) {
-			muteSoloGainSlewer.process(gInfo->sampleTime, fadeGainScaledWithSolo);
-		}
-		taps[N_TRK * 6 + 0] = taps[N_TRK * 4 + 0] * muteSoloGainSlewer.out;
-		taps[N_TRK * 6 + 1] = taps[N_TRK * 4 + 1] * muteSoloGainSlewer.out;
-			
-			
-		// Add to final mix or group
-		if (paGroup->getValue() < 0.5f) {
-			mix[0] += taps[N_TRK * 6 + 0];
-			mix[1] += taps[N_TRK * 6 + 1];
+
+	// inserts, reads tap[32],[33] and writes them and the insert outs
+	// the track bank has already copied tap[0],[1] into tap[32],[33] and done the filters when they are pre-insert
+	void processInserts() {
+		int insertPortIndex = trackNum >> 3;		
+		// Insert outputs
+		if (isFilterPostInsert()) {
+			insertOuts[0] = taps[0];
+			insertOuts[1] = stereo ? taps[1] : 0.0f;// don't send to R of insert outs when mono
 		}
 		else {
-			int groupIndex = (int)(paGroup->getValue() - 0.5f);
-			groupTaps[(groupIndex << 1) + 0] += taps[N_TRK * 6 + 0];
-			groupTaps[(groupIndex << 1) + 1] += taps[N_TRK * 6 + 1];
+			insertOuts[0] = taps[N_TRK * 2 + 0];
+			insertOuts[1] = stereo ? taps[N_TRK * 2 + 1] : 0.0f;// don't send to R of insert outs when mono!
 		}
 		
-		// VUs
-		if (gInfo->colorAndCloak.cc4[cloakedMode] != 0) {
-			vu.reset();
-		}
-		else if (eco) {
-			float sampleTimeEco = gInfo->sampleTime * (1 + (gInfo->ecoMode & 0x3));
-			vu.process(sampleTimeEco, &taps[N_TRK * (fadeGainScaledWithSolo == 0.0f ? 4 : 6) + 0]);
+		// Insert inputs
+		if (inInsert[insertPortIndex].isConnected()) {
+			taps[N_TRK * 2 + 0] = clampNothing(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 0));
+			taps[N_TRK * 2 + 1] = stereo ? clampNothing(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 1)) : taps[N_TRK * 2 + 0];// don't receive from R of insert outs when mono, just normal L into R (need this for aux sends)
 		}
 	}
 };// struct MixerTrack
@@ -2171,13 +2303,14 @@ struct MixerAux {
 		fadeGainScaled = fadeGain;// no pow needed here since 0.0f or 1.0f
 		fadeGainScaledWithSolo = fadeGainScaled;
 		soloGain = 1.0f;
+		gInfo->requestSlowDirty(GlobalInfo::SLOW_AUX + auxNum);// soloGain above
 	}	
 
 	void dataToJson(json_t *rootJ) {}
 	void dataFromJson(json_t *rootJ) {}
 	
 	float calcSoloGain() {
-		if (gInfo->soloBitMask != 0 && gInfo->auxReturnsMutedWhenMainSolo) {
+		if (gInfo->soloBitMask.any() && gInfo->auxReturnsMutedWhenMainSolo) {
 			// Handle "Mute aux returns when soloing track"
 			// i.e. add aux returns to mix when no solo, or when solo and don't want mutes aux returns
 			return 0.0f;
@@ -2231,9 +2364,9 @@ struct MixerAux {
 			}
 			if (fadeGain != target) {
 				if (isFadeMode()) {
-					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
+					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + gInfo->ecoMask);// last value is sub refresh
 					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, *fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::globalAuxReturnScalingExponent);
+					fadeGainScaled = powInt(fadeGain, GlobalConst::globalAuxReturnScalingExponent);
 				}
 				else {// we are in mute mode
 					fadeGain = target;
@@ -2313,8 +2446,7 @@ struct MixerAux {
 			vu.reset();
 		}
 		else if (eco) {
-			float sampleTimeEco = gInfo->sampleTime * (1 + (gInfo->ecoMode & 0x3));
-			vu.process(sampleTimeEco, &taps[(fadeGainScaledWithSolo == 0.0f ? 16 : 24) + 0]);
+			gInfo->vuBank.add(&vu, &taps[(fadeGainScaledWithSolo == 0.0f ? 16 : 24) + 0]);
 		}
 
 	}
@@ -56,6 +56,41 @@ struct MixerInterchangeItem : MenuItem {
 
 
 
+// Latency of the chain inputs relative to the tracks, in samples: one per cable up the chain (Rack's engine steps the 
+// cables after all the modules).
+static int calcChainLatency(Module* module, int chainInputId) {
+	int latency = 0;
+	for (int hops = 0; hops < 16; hops++) {// bounds a chain that loops back on itself
+		Module* upstream = NULL;
+		for (int64_t cableId : APP->engine->getCableIds()) {
+			engine::Cable* cable = APP->engine->getCable(cableId);
+			if (cable && cable->inputModule == module && (cable->inputId == chainInputId || cable->inputId == chainInputId + 1)) {
+				upstream = cable->outputModule;
+				break;
+			}
+		}
+		if (!upstream) {
+			break;
+		}
+		latency++;
+		if (upstream->model == modelMixMaster) {
+			chainInputId = MixMaster<16, 4>::CHAIN_INPUTS;
+		}
+		else if (upstream->model == modelMixMasterJr) {
+			chainInputId = MixMaster<8, 2>::CHAIN_INPUTS;
+		}
+		else if (upstream->model == modelMixMaster32) {
+			chainInputId = MixMaster<32, 4>::CHAIN_INPUTS;
+		}
+		else {
+			break;// chained from something other than a mixer
+		}
+		module = upstream;
+	}
+	return latency;
+}
+
+
 void appendContextMenu(Menu *menu) override {		
 	TMixMaster* module = static_cast<TMixMaster*>(this->module);
 	assert(module);
@@ -77,12 +112,14 @@ void appendContextMenu(Menu *menu) override {
 	
 	PanLawMonoItem *panLawMonoItem = createMenuItem<PanLawMonoItem>("Mono pan law", RIGHT_ARROW);
 	panLawMonoItem->panLawMonoSrc = &(module->gInfo->panLawMono);
+	panLawMonoItem->slowDirtyRequest = module->gInfo->slowDirtyRequestAll();
 	menu->addChild(panLawMonoItem);
 	
 	PanLawStereoItem *panLawStereoItem = createMenuItem<PanLawStereoItem>("Stereo pan mode", RIGHT_ARROW);
 	panLawStereoItem->panLawStereoSrc = &(module->gInfo->directOutPanStereoMomentCvLinearVol.cc4[1]);
 	panLawStereoItem->isGlobal = true;
 	panLawStereoItem->localOp = &(module->globalToLocalOp);
+	panLawStereoItem->slowDirtyRequest = module->gInfo->slowDirtyRequestAll();
 	menu->addChild(panLawStereoItem);
 	
 	ChainItem *chainItem = createMenuItem<ChainItem>("Chain input", RIGHT_ARROW);
@@ -116,10 +153,73 @@ void appendContextMenu(Menu *menu) override {
 		[=]() {module->gInfo->polySpreadVandP ^= 0x1;}
 	));
 
-	menu->addChild(createCheckMenuItem("Eco mode", "",
-		[=]() {return module->gInfo->ecoMode != 0;},
-		[=]() {module->gInfo->ecoMode = ~module->gInfo->ecoMode;}
-	));
+	std::string ecoRight = (module->gInfo->ecoAdaptive != 0 ? string::f("Adaptive (1/%i)", module->gInfo->ecoMask + 1) : (module->gInfo->ecoMode != 0 ? "On" : "Off"));
+	menu->addChild(createSubmenuItem("Eco mode", ecoRight, [=](Menu* menu) {
+		menu->addChild(createCheckMenuItem("Off", "",
+			[=]() {return module->gInfo->ecoAdaptive == 0 && module->gInfo->ecoMode == 0;},
+			[=]() {module->gInfo->ecoMode = 0; module->gInfo->ecoAdaptive = 0;}
+		));
+		menu->addChild(createCheckMenuItem("On (1/4 control rate)", "",
+			[=]() {return module->gInfo->ecoAdaptive == 0 && module->gInfo->ecoMode != 0;},
+			[=]() {module->gInfo->ecoMode = 0xFFFF; module->gInfo->ecoAdaptive = 0;}
+		));
+		menu->addChild(createCheckMenuItem("Adaptive", "",
+			[=]() {return module->gInfo->ecoAdaptive != 0;},
+			[=]() {module->gInfo->ecoAdaptive = 1;}
+		));
+		if (module->gInfo->ecoAdaptive != 0) {
+			// cost of MixMaster and its AuxSpander, as last measured by the adaptive eco
+			float costNs = module->ecoMeter.costNs + module->expanderEcoCostNs;
+			float periodNs = 1e9f / APP->engine->getSampleRate();
+			menu->addChild(createSubmenuItem("Budget", string::f("%i%%", module->gInfo->ecoBudget), [=](Menu* menu) {
+				const int8_t budgets[4] = {1, 2, 5, 10};
+				for (int b = 0; b < 4; b++) {
+					int8_t budget = budgets[b];
+					menu->addChild(createCheckMenuItem(string::f("%i%% of the sample period", budget), "",
+						[=]() {return module->gInfo->ecoBudget == budget;},
+						[=]() {module->gInfo->ecoBudget = budget;}
+					));
+				}
+			}));
+			menu->addChild(new MenuSeparator());
+			menu->addChild(createMenuLabel(string::f("Control rate 1/%i, %.0f ns per sample (%.1f%%)", module->gInfo->ecoMask + 1, costNs, 100.0f * costNs / periodNs)));
+		}
+	}));
+
+	if (module->inputs[TMixMaster::CHAIN_INPUTS + 0].isConnected() || module->inputs[TMixMaster::CHAIN_INPUTS + 1].isConnected()) {
+		int chainLatency = calcChainLatency(module, TMixMaster::CHAIN_INPUTS);
+		menu->addChild(createMenuLabel(string::f("Chain latency: %i samples (%.2f ms)", chainLatency, 1000.0f * chainLatency / APP->engine->getSampleRate())));
+	}
+
+	#ifdef MM_PROFILE
+	menu->addChild(createSubmenuItem("Profiling", "", [=](Menu* menu) {
+		// snapshot of the totals accumulated by the audio thread since the last reset
+		StageProfiler* profiler = &module->profiler;
+		uint64_t samples = std::max(profiler->numSamples, (uint64_t)1);
+		uint64_t total = std::max(profiler->getTotalNs(), (uint64_t)1);
+		menu->addChild(createMenuLabel(string::f("%.2f s profiled, %.0f ns per sample", (double)profiler->numSamples / APP->engine->getSampleRate(), (double)total / samples)));
+		for (int i = 0; i < NUM_PROF_STAGES; i++) {
+			menu->addChild(createMenuLabel(string::f("%s: %.1f ns (%.1f%%)", StageProfiler::stageName(i), (double)profiler->totalNs[i] / samples, 100.0 * profiler->totalNs[i] / total)));
+		}
+		menu->addChild(new MenuSeparator());
+		menu->addChild(createMenuItem("Reset", "",
+			[=]() {profiler->resetRequest = true;}
+		));
+		menu->addChild(createMenuItem("Dump to CSV", "",
+			[=]() {
+				std::string dir = asset::user("MindMeldModular");
+				system::createDirectory(dir);
+				std::string path = system::join(dir, string::f("MixMasterProfile-%" PRId64 ".csv", module->id));
+				if (profiler->dumpCsv(path)) {
+					INFO("MixMaster profile written to %s", path.c_str());
+				}
+				else {
+					WARN("MixMaster profile could not be written to %s", path.c_str());
+				}
+			}
+		));
+	}));
+	#endif
 
 	if (module->auxExpanderPresent) {
 		menu->addChild(new MenuSeparator());
@@ -136,6 +236,7 @@ void appendContextMenu(Menu *menu) override {
 		AuxReturnItem *auxRetunsItem = createMenuItem<AuxReturnItem>("Aux returns", RIGHT_ARROW);
 		auxRetunsItem->auxReturnsMutedWhenMainSoloPtr = &(module->gInfo->auxReturnsMutedWhenMainSolo);
 		auxRetunsItem->auxReturnsSolosMuteDryPtr = &(module->gInfo->auxReturnsSolosMuteDry);
+		auxRetunsItem->slowDirtyRequest = module->gInfo->slowDirtyRequestAll();
 		menu->addChild(auxRetunsItem);
 	
 		AuxRetFbProtItem *fbpItem = createMenuItem<AuxRetFbProtItem>("Routing returns to groups", RIGHT_ARROW);
@@ -172,6 +273,14 @@ void appendContextMenu(Menu *menu) override {
 		[=]() {return module->gInfo->colorAndCloak.cc4[cloakedMode];},
 		[=]() {module->gInfo->colorAndCloak.cc4[cloakedMode] ^= 0xFF;}
 	));
+	
+	
+	menu->addChild(new MenuSeparator());
+	
+	menu->addChild(createCheckMenuItem("Save patches for older plugin versions", "",
+		[=]() {return isMmSaveLegacyStripKeys();},
+		[=]() {toggleMmSaveLegacyStripKeys();}
+	));
 }
 
 
@@ -254,6 +363,7 @@ void step() override {
 					for (int i = 0; i < N_GRP; i++) {
 						module->groups[i].panLawStereo = module->globalToLocalOp.operand;
 					}
+					module->gInfo->requestAllSlowDirty();
 					break;
 				}
 				case (GTOL_AUXSENDS) : {
@@ -393,12 +503,20 @@ void step() override {
 			// more input port tooltips
 			module->inputInfos[TMixMaster::CHAIN_INPUTS + 0]->name = "Chain left";
 			module->inputInfos[TMixMaster::CHAIN_INPUTS + 1]->name = "Chain right";
-			module->inputInfos[TMixMaster::INSERT_TRACK_INPUTS + 0]->name = "Insert 1-8";
-			if (N_TRK > 8) {
-				module->inputInfos[TMixMaster::INSERT_TRACK_INPUTS + 1]->name = "Insert 9-16";
+			for (int i = 0; i < N_TRK / 8; i++) {
+				snprintf(strBuf, 32, "Insert %i-%i", i * 8 + 1, i * 8 + 8);
+				module->inputInfos[TMixMaster::INSERT_TRACK_INPUTS + i]->name = strBuf;
 			}
 			module->inputInfos[TMixMaster::INSERT_GRP_AUX_INPUT]->name = "Insert group/aux";
-			if (N_TRK > 8) {
+			if (N_TRK > 16) {
+				for (int i = 0; i < N_TRK / 16; i++) {
+					snprintf(strBuf, 32, "Track mute %i-%i", i * 16 + 1, i * 16 + 16);
+					module->inputInfos[TMixMaster::TRACK_MUTESOLO_INPUTS + i]->name = strBuf;
+					snprintf(strBuf, 32, "Track solo %i-%i", i * 16 + 1, i * 16 + 16);
+					module->inputInfos[TMixMaster::TRACK_MUTESOLO_INPUTS + N_TRK / 16 + i]->name = strBuf;
+				}
+			}
+			else if (N_TRK > 8) {
 				module->inputInfos[TMixMaster::TRACK_MUTESOLO_INPUTS + 0]->name = "Track mute";
 				module->inputInfos[TMixMaster::TRACK_MUTESOLO_INPUTS + 1]->name = "Track solo";
 			}
@@ -408,22 +526,27 @@ void step() override {
 			module->inputInfos[TMixMaster::GRPM_MUTESOLO_INPUT]->name = "Mute/solo group, CV master";
 			
 			//output port tooltips
-			module->outputInfos[TMixMaster::DIRECT_OUTPUTS + 0]->name = "Direct 1-8";
-			if (N_TRK > 8) {
-				module->outputInfos[TMixMaster::DIRECT_OUTPUTS + 1]->name = "Direct 9-16";
-				module->outputInfos[TMixMaster::DIRECT_OUTPUTS + 2]->name = "Direct group/aux";
-			}
-			else {
-				module->outputInfos[TMixMaster::DIRECT_OUTPUTS + 1]->name = "Direct group/aux";
+			for (int i = 0; i < N_TRK / 8; i++) {
+				snprintf(strBuf, 32, "Direct %i-%i", i * 8 + 1, i * 8 + 8);
+				module->outputInfos[TMixMaster::DIRECT_OUTPUTS + i]->name = strBuf;
 			}
+			module->outputInfos[TMixMaster::DIRECT_OUTPUTS + N_TRK / 8]->name = "Direct group/aux";
 			module->outputInfos[TMixMaster::MAIN_OUTPUTS + 0]->name = "Main left";
 			module->outputInfos[TMixMaster::MAIN_OUTPUTS + 1]->name = "Main right";
-			module->outputInfos[TMixMaster::INSERT_TRACK_OUTPUTS + 0]->name = "Insert 1-8";
-			if (N_TRK > 8) {		
-				module->outputInfos[TMixMaster::INSERT_TRACK_OUTPUTS + 1]->name = "Insert 9-16";
+			for (int i = 0; i < N_TRK / 8; i++) {
+				snprintf(strBuf, 32, "Insert %i-%i", i * 8 + 1, i * 8 + 8);
+				module->outputInfos[TMixMaster::INSERT_TRACK_OUTPUTS + i]->name = strBuf;
 			}
 			module->outputInfos[TMixMaster::INSERT_GRP_AUX_OUTPUT]->name = "Insert group/aux";
-			module->outputInfos[TMixMaster::FADE_CV_OUTPUT]->name = "Fade CV";
+			if (N_TRK > 16) {
+				for (int i = 0; i < N_TRK / 16; i++) {
+					snprintf(strBuf, 32, "Fade CV %i-%i", i * 16 + 1, i * 16 + 16);
+					module->outputInfos[TMixMaster::FADE_CV_OUTPUT + i]->name = strBuf;
+				}
+			}
+			else {
+				module->outputInfos[TMixMaster::FADE_CV_OUTPUT]->name = "Fade CV";
+			}
 			
 			
 			// Mixer Message Bus (for EQ and others)
@@ -19,15 +19,87 @@
 
 // Utility
 
+// Fade curves of updateFadeGain(), in lookup tables so that no std::expm1(), std::log1p() or std::exp() is needed while fading.
+// The exp curve is expm1(A*x)/(e^A - 1) and the log curve is its inverse, log1p(x*(e^A - 1))/A, for x in [0.0f : 1.0f].
+// Every fade profile is a crossfade of the linear fade with one of these two curves, and asymmetrical fades move along the
+// crossfaded curve from where they start, so the two tables serve all profiles in both symmetrical and asymmetrical fades.
+// Each segment is the cubic that matches the curve and its slope at both ends (Hermite), which is within 4e-7 of the exact
+// curves (worst case is the steep start of the log curve), about the precision of the floats; x beyond 1.0f extends the last segment.
+// The error of whole fades against std::expm1() and std::log1p() is checked in bench/ModuleBench for every profile.
+struct FadeCurves {
+	static const int N_SEG = 512;
+	float expCoefs[N_SEG][4];// c0 + c1*t + c2*t^2 + c3*t^3, with t in [0.0f : 1.0f] across the segment
+	float logCoefs[N_SEG][4];
+	
+	FadeCurves() {
+		const double A = 4.0;
+		const double E_A_M1 = std::expm1(A);// e^A - 1
+		for (int i = 0; i < N_SEG; i++) {
+			double x0 = (double)i / (double)N_SEG;
+			double x1 = (double)(i + 1) / (double)N_SEG;
+			// slopes are scaled to the segment's width
+			setSegment(expCoefs[i], std::expm1(A * x0) / E_A_M1, std::expm1(A * x1) / E_A_M1, 
+				A * std::exp(A * x0) / E_A_M1 / N_SEG, A * std::exp(A * x1) / E_A_M1 / N_SEG);
+			setSegment(logCoefs[i], std::log1p(x0 * E_A_M1) / A, std::log1p(x1 * E_A_M1) / A, 
+				E_A_M1 / (A * (1.0 + x0 * E_A_M1)) / N_SEG, E_A_M1 / (A * (1.0 + x1 * E_A_M1)) / N_SEG);
+		}
+	}
+	static void setSegment(float* coefs, double y0, double y1, double m0, double m1) {
+		coefs[0] = (float)y0;
+		coefs[1] = (float)m0;
+		coefs[2] = (float)(3.0 * (y1 - y0) - 2.0 * m0 - m1);
+		coefs[3] = (float)(2.0 * (y0 - y1) + m0 + m1);
+	}
+	
+	static float lookup(const float (*coefs)[4], float x) {
+		float pos = std::fmax(x, 0.0f) * N_SEG;
+		int i = std::min((int)pos, N_SEG - 1);
+		float t = pos - (float)i;
+		const float* c = coefs[i];
+		return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+	}
+	static simd::float_4 lookup(const float (*coefs)[4], simd::float_4 x) {
+		simd::float_4 pos = simd::fmax(x, 0.0f) * (float)N_SEG;
+		simd::float_4 c[4];
+		simd::float_4 t;
+		for (int l = 0; l < 4; l++) {
+			int i = std::min((int)pos[l], N_SEG - 1);
+			for (int k = 0; k < 4; k++) {
+				c[k][l] = coefs[i][k];
+			}
+			t[l] = pos[l] - (float)i;
+		}
+		return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+	}
+	
+	template<typename T>
+	T expCurve(T x) const {
+		return lookup(expCoefs, x);
+	}
+	template<typename T>
+	T logCurve(T x) const {
+		return lookup(logCoefs, x);
+	}
+};
+
+static const FadeCurves fadeCurves;
+
+// Rack builds with -funsafe-math-optimizations, which would turn (fadeGain - curvePrev) + curveNow back into 
+// fadeGain + (curveNow - curvePrev) and bring back the rounding errors that the rebase below avoids; going through memory stops it
+template<typename T>
+static inline T keepRounding(T x) {
+	__asm__("" : "+m"(x));
+	return x;
+}
+
+
 float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fadeGainXr, float timeStepX, float shape, bool symmetricalFade) {
 	// shape is 1.0f when exp, 0.0f when lin, -1.0f when log
 	// target is 0.0f or 1.0f
 	// fadeGainX moves from 0.0f to 1.0f gradually and linearly
 	// fadeGainXr is a resettable and relative gainX, which is used for non-symmetrical fades (to remember position when change direction while fade is happening
-	static const float A = 4.0f;
-	static const float E_A_M1 = std::expm1(A);// e^A - 1
-	
 	float newFadeGain;
+	float xPrev = *fadeGainXr;
 
 	if (target < *fadeGainX) {
 		*fadeGainX -= timeStepX;
@@ -47,33 +119,38 @@ float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fade
 		newFadeGain = *fadeGainX;// linear
 		if (*fadeGainX != target) {
 			if (shape > 0.0f) {	
-				float expY = std::expm1(A * *fadeGainX)/E_A_M1;
+				float expY = fadeCurves.expCurve(*fadeGainX);
 				newFadeGain = crossfade(newFadeGain, expY, shape);
 			}
 			else if (shape < 0.0f) {
-				float logY = std::log1p(*fadeGainX * E_A_M1) / A;
+				float logY = fadeCurves.logCurve(*fadeGainX);
 				newFadeGain = crossfade(newFadeGain, logY, -1.0f * shape);		
 			}
 		}
 	}
 	else {// asymmetrical fade
-		float fadeGainDelta = timeStepX;// linear
+		// the gain moves by the step of the crossfaded curve between the previous and the new fadeGainXr; it is rebased on
+		// the curve and moved to its new point, instead of adding the step, so that rounding errors do not pile up in long fades
+		float curveNow = *fadeGainXr;// linear
+		float curvePrev = xPrev;
 		
 		if (shape > 0.0f) {	
-			float fadeGainDeltaExp = (std::exp(A * (*fadeGainXr)) - std::exp(A * (*fadeGainXr - timeStepX))) / E_A_M1;
-			fadeGainDelta = crossfade(fadeGainDelta, fadeGainDeltaExp, shape);
+			curveNow = crossfade(curveNow, fadeCurves.expCurve(*fadeGainXr), shape);
+			curvePrev = crossfade(curvePrev, fadeCurves.expCurve(xPrev), shape);
 		}
 		else if (shape < 0.0f) {
-			float fadeGainDeltaLog = (std::log1p((*fadeGainXr) * E_A_M1) - std::log1p((*fadeGainXr - timeStepX) * E_A_M1)) / A;
-			fadeGainDelta = crossfade(fadeGainDelta, fadeGainDeltaLog, -1.0f * shape);		
+			curveNow = crossfade(curveNow, fadeCurves.logCurve(*fadeGainXr), -1.0f * shape);
+			curvePrev = crossfade(curvePrev, fadeCurves.logCurve(xPrev), -1.0f * shape);
 		}
 		
 		newFadeGain = fadeGain;
 		if (target > fadeGain) {
-			newFadeGain += fadeGainDelta;
+			float base = keepRounding(fadeGain - curvePrev);
+			newFadeGain = base + curveNow;
 		}
 		else if (target < fadeGain) {
-			newFadeGain -= fadeGainDelta;
+			float base = keepRounding(fadeGain + curvePrev);
+			newFadeGain = base - curveNow;
 		}	
 
 		if (target > fadeGain && target < newFadeGain) {
@@ -88,4 +165,33 @@ float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fade
 }
 
 
-
+simd::float_4 updateFadeGain(simd::float_4 fadeGain, simd::float_4 target, simd::float_4 *fadeGainX, simd::float_4 *fadeGainXr, simd::float_4 timeStepX, simd::float_4 shape, bool symmetricalFade) {
+	// same as the scalar version above, for four fades at once (each lane has its own target, time step and shape)
+	simd::float_4 curveMix = simd::fabs(shape);// crossfade amount of the exp (shape > 0) or log (shape < 0) curve
+	simd::float_4 expMask = shape > 0.0f;
+	simd::float_4 newFadeGain;
+	simd::float_4 xPrev = *fadeGainXr;
+	
+	*fadeGainX = simd::ifelse(target < *fadeGainX, simd::fmax(*fadeGainX - timeStepX, target), 
+		simd::ifelse(target > *fadeGainX, simd::fmin(*fadeGainX + timeStepX, target), *fadeGainX));
+	*fadeGainXr += timeStepX;
+	
+	if (symmetricalFade) {
+		simd::float_4 curveY = simd::ifelse(expMask, fadeCurves.expCurve(*fadeGainX), fadeCurves.logCurve(*fadeGainX));
+		newFadeGain = *fadeGainX + (curveY - *fadeGainX) * curveMix;
+		newFadeGain = simd::ifelse(*fadeGainX != target, newFadeGain, *fadeGainX);
+	}
+	else {// asymmetrical fade
+		simd::float_4 curveNow = simd::ifelse(expMask, fadeCurves.expCurve(*fadeGainXr), fadeCurves.logCurve(*fadeGainXr));
+		simd::float_4 curvePrev = simd::ifelse(expMask, fadeCurves.expCurve(xPrev), fadeCurves.logCurve(xPrev));
+		curveNow = *fadeGainXr + (curveNow - *fadeGainXr) * curveMix;
+		curvePrev = xPrev + (curvePrev - xPrev) * curveMix;
+		
+		simd::float_4 baseUp = keepRounding(fadeGain - curvePrev);
+		simd::float_4 baseDown = keepRounding(fadeGain + curvePrev);
+		newFadeGain = simd::ifelse(target > fadeGain, simd::fmin(baseUp + curveNow, target), 
+			simd::ifelse(target < fadeGain, simd::fmax(baseDown - curveNow, target), fadeGain));
+	}
+	
+	return newFadeGain;
+}
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "../MindMeldModular.hpp"
+#include <chrono>
+#include <cinttypes>
 #include "../dsp/FirstOrderFilter.hpp"
 #include "../dsp/ButterworthFilters.hpp"
 
@@ -39,21 +41,76 @@ struct GlobalToLocalOp {
 //*****************************************************************************
 // Communications between mixer and auxspander
 
+// Shared transport between a mixer and its aux expander, used instead of the double-buffered messages of Rack's expanders.
+// It lives in the reading module (its producerMessage and consumerMessage both point to it), and no flip is ever requested.
+// Fast data has two slots indexed by the parity of the engine frame: the writer fills the slot of the current frame
+// while the reader takes the slot of the previous frame, so both never touch the same slot in a frame (even when the
+// engine runs them in different threads), and the one sample delay of Rack's messages is kept.
+// Slow data is versioned: the writer only publishes its slow values when they differ from the last ones it published
+// (or when forced), and the reader only copies them when it sees a new version.
+template <typename TFast, typename TSlow>
+struct ExpTransport {
+	struct Slot {
+		TFast fast;
+		uint32_t slowVersion = 0;
+		TSlow slow;
+		char pad[64];// a cache line of padding between the slots, so that the writer and the reader never share a line (alignas(64) would over-align the modules, which Rack's C++11 new doesn't honor)
+	};
+	Slot slots[2];
+	
+	// writer side
+	TSlow slowToWrite;// filled by the writer before publishSlow()
+	TSlow slowPublished;
+	uint32_t slowVersion = 0;
+	bool slowResync = true;// publish the next slow values even when unchanged, set by the writer when the reader was (re)attached
+	
+	// reader side
+	uint32_t slowVersionRead = 0;
+	
+	
+	TFast* fastToWrite(int64_t frame) {
+		return &slots[frame & 0x1].fast;
+	}
+	TFast* fastToRead(int64_t frame) {
+		return &slots[(frame - 1) & 0x1].fast;
+	}
+	
+	void publishSlow(int64_t frame, bool force) {// force is for one-shot requests, which must go through even when the same as last time
+		// slowToWrite is only ever assigned field by field, so its padding does not change and memcmp is safe
+		if (force || slowResync || memcmp(&slowToWrite, &slowPublished, sizeof(TSlow)) != 0) {
+			memcpy(&slowPublished, &slowToWrite, sizeof(TSlow));
+			Slot* slot = &slots[frame & 0x1];
+			memcpy(&slot->slow, &slowToWrite, sizeof(TSlow));
+			slot->slowVersion = ++slowVersion;
+			slowResync = false;
+		}
+	}
+	TSlow* slowToRead(int64_t frame) {// NULL when nothing new was published
+		Slot* slot = &slots[(frame - 1) & 0x1];
+		if ((int32_t)(slot->slowVersion - slowVersionRead) <= 0) {
+			return NULL;
+		}
+		slowVersionRead = slot->slowVersion;
+		return &slot->slow;
+	}
+};
+
+
 template <int N_TRK, int N_GRP>
-struct TAfmExpInterface {// messages to expander from mother (data is in expander, mother writes into expander)
-	// Fast (sample-rate)	
-	bool updateSlow = false;
+struct TAfmExpFast {// sample-rate values to expander from mother
 	float auxSends[(N_TRK + N_GRP) * 2] = {};
 	int vuIndex = 0;
 	float vuValues[4] = {};
-	
-	// Slow (sample-rate / 256), no need to init
+};
+
+template <int N_TRK, int N_GRP>
+struct TAfmExpSlow {// sample-rate / 256 values to expander from mother, only when changed
 	PackedBytes4 colorAndCloak;
 	PackedBytes4 directOutPanStereoMomentCvLinearVol;
 	uint32_t muteAuxSendWhenReturnGrouped = 0;
-	uint16_t ecoMode = 0;// all 1's means yes, 0 means no
+	uint16_t ecoMode = 0;// control-rate divider minus one of the mother (0 is no eco), see GlobalInfo::ecoMask
 	int32_t trackMoveInAuxRequest = 0;// 0 when nothing to do, {dest,src} packed when a move is requested
-	int8_t trackOrGroupResetInAux = 0;// -1 when nothing to do, 0 to N_TRK-1 for track reset, N_TRK to N_TRK+N_GRP-1 for group reset 
+	int8_t trackOrGroupResetInAux = -1;// -1 when nothing to do, 0 to N_TRK-1 for track reset, N_TRK to N_TRK+N_GRP-1 for group reset 
 	alignas(4) char trackLabels[4 * (N_TRK + N_GRP)] = {};
 	PackedBytes4 trackDispColsLocal[N_TRK / 4 + 1];// only valid when colorAndCloak.cc4[dispColorGlobal] >= numDispThemes
 	float auxRetFadeGains[4] = {};
@@ -61,14 +118,17 @@ struct TAfmExpInterface {// messages to expander from mother (data is in expande
 	GlobalToLocalOp globalToLocalOp;
 };
 
+template <int N_TRK, int N_GRP>
+struct TAfmExpInterface : ExpTransport<TAfmExpFast<N_TRK, N_GRP>, TAfmExpSlow<N_TRK, N_GRP>> {};// to expander from mother (lives in expander)
 
-struct MfaExpInterface {// messages to mother from expander (data is in mother, expander writes into mother)
-	// Fast (sample-rate)	
-	bool updateSlow = false;
+
+struct MfaExpFast {// sample-rate values to mother from expander
 	float auxReturns[8] = {};
 	float auxRetFaderPanFadercv[12] = {};
-	
-	// Slow (sample-rate / 256), no need to init
+	float ecoCostNs = 0.0f;// cost of the expander's process(), for the mother's adaptive eco
+};
+
+struct MfaExpSlow {// sample-rate / 256 values to mother from expander, only when changed
 	PackedBytes4 directOutsModeLocalAux;
 	PackedBytes4 stereoPanModeLocalAux;
 	PackedBytes4 auxVuColors;
@@ -77,6 +137,230 @@ struct MfaExpInterface {// messages to mother from expander (data is in mother,
 	alignas(4) char auxLabels[4 * 4] = {};
 };
 
+struct MfaExpInterface : ExpTransport<MfaExpFast, MfaExpSlow> {};// to mother from expander (lives in mother)
+
+
+
+//*****************************************************************************
+// Adaptive eco
+
+// Cost of a module's process() in ns per sample, for the adaptive eco mode. Only the first WINDOW samples of each
+// light refresh period (of 256 samples) are timed, so the clock is read 32 times per period; the window holds one input
+// refresh, as do any 16 consecutive samples, and all the eco staggers. Each window's average is smoothed into costNs.
+struct EcoMeter {
+	static const uint16_t WINDOW = 16;
+	
+	std::chrono::steady_clock::time_point start;
+	double windowNs = 0.0;
+	float costNs = 0.0f;
+	
+	
+	bool begin(uint16_t refreshCounter) {// returns true when this sample is timed, end() must then be called after process()
+		if (refreshCounter >= WINDOW) {
+			return false;
+		}
+		start = std::chrono::steady_clock::now();
+		return true;
+	}
+	void end(uint16_t refreshCounter) {
+		windowNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		if (refreshCounter == WINDOW - 1) {
+			costNs += ((float)(windowNs / WINDOW) - costNs) * 0.25f;
+			windowNs = 0.0;
+		}
+	}
+};
+
+
+
+//*****************************************************************************
+// Stage profiling
+
+// Time spent in each stage of MixMaster's process(), for finding what a spiking mixer is busy with. Compiled in only 
+// when the plugin is built with MM_PROFILE defined (FLAGS += -DMM_PROFILE in the Makefile); otherwise the MM_PROF_ 
+// macros expand to nothing and there is no trace of it in process(). Each lap() charges the time since the previous 
+// mark to a stage. Totals are written by the audio thread and read by the ui thread, which only asks for resets.
+#ifdef MM_PROFILE
+
+enum ProfStageIds {PROF_EXP_READ, PROF_SLOW, PROF_TRACKS, PROF_GRP_AUX_RET, PROF_GROUPS, PROF_AUX, PROF_MASTER, PROF_VUS, PROF_OUTS, PROF_EXP_WRITE, NUM_PROF_STAGES};
+
+struct StageProfiler {
+	std::chrono::steady_clock::time_point mark;
+	uint64_t totalNs[NUM_PROF_STAGES] = {};
+	uint64_t numSamples = 0;
+	bool resetRequest = false;// set by ui thread, done by audio thread in start()
+	
+	
+	static const char* stageName(int stage) {
+		static const char* names[NUM_PROF_STAGES] = {"Expander read", "Slow values", "Tracks", "Grouped aux returns", "Groups", "Aux", "Master", "VUs", "Outs and lights", "Expander write"};
+		return names[stage];
+	}
+	
+	void start() {
+		if (resetRequest) {
+			for (int i = 0; i < NUM_PROF_STAGES; i++) {
+				totalNs[i] = 0;
+			}
+			numSamples = 0;
+			resetRequest = false;
+		}
+		numSamples++;
+		mark = std::chrono::steady_clock::now();
+	}
+	void lap(int stage) {
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		totalNs[stage] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark).count();
+		mark = now;
+	}
+	
+	uint64_t getTotalNs() {
+		uint64_t total = 0;
+		for (int i = 0; i < NUM_PROF_STAGES; i++) {
+			total += totalNs[i];
+		}
+		return total;
+	}
+	
+	// one row per stage: total ns, ns per sample and share of the whole process(); returns false when the file can't be written
+	bool dumpCsv(const std::string& path) {
+		FILE* file = std::fopen(path.c_str(), "w");
+		if (!file) {
+			return false;
+		}
+		uint64_t samples = std::max(numSamples, (uint64_t)1);
+		uint64_t total = std::max(getTotalNs(), (uint64_t)1);
+		std::fprintf(file, "stage,total_ns,ns_per_sample,percent\n");
+		for (int i = 0; i < NUM_PROF_STAGES; i++) {
+			std::fprintf(file, "%s,%" PRIu64 ",%.2f,%.2f\n", stageName(i), totalNs[i], (double)totalNs[i] / samples, 100.0 * totalNs[i] / total);
+		}
+		std::fprintf(file, "samples,%" PRIu64 ",,\n", numSamples);
+		std::fclose(file);
+		return true;
+	}
+};
+
+#define MM_PROF_START(profiler) (profiler).start()
+#define MM_PROF_LAP(profiler, stage) (profiler).lap(stage)
+
+#else
+
+#define MM_PROF_START(profiler)
+#define MM_PROF_LAP(profiler, stage)
+
+#endif
+
+
+
+//*****************************************************************************
+// Settings blob
+
+// Compact binary form of the settings of a module's strips, saved base64-encoded in a single json string, so that 
+// loading a patch doesn't have to go through the hundreds of per-strip keys. Each strip puts its fields in one record
+// in its dataToBlob(), and gets them back in the same order in its dataFromBlob(). Records are prefixed with their size:
+// a record that is shorter than what the strip reads (written by an older version) leaves the missing fields untouched,
+// as a missing json key would, and a longer one (fields added at the end by a newer version) is skipped past, 
+// as are the records of strips that the module doesn't have. Only a change that breaks this must bump VERSION.
+struct SettingsBlob {
+	static const uint8_t VERSION = 1;
+	
+	std::vector<uint8_t> data;
+	size_t pos = 0;
+	size_t recordStart = 0;
+	size_t recordEnd = 0;
+	bool inRecord = false;// a short read inside a record isn't an error, the fields that are missing are left as they are
+	bool error = false;// set when a read goes past the end of the blob, the settings can't be trusted in that case
+	
+	
+	// writing
+	template<typename T>
+	void put(T value) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(T));
+	}
+	void putBytes(const void* src, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src);
+		data.insert(data.end(), bytes, bytes + size);
+	}
+	void beginRecord() {
+		recordStart = data.size();
+		put<uint16_t>(0);// size, set in endRecord()
+	}
+	void endRecord() {
+		uint16_t size = (uint16_t)(data.size() - recordStart - 2);
+		memcpy(&data[recordStart], &size, 2);
+	}
+	std::string toBase64() {
+		return string::toBase64(data);
+	}
+	
+	
+	// reading
+	bool fromBase64(const char* str) {
+		try {
+			data = string::fromBase64(str);
+		}
+		catch (std::exception& e) {
+			return false;
+		}
+		pos = 0;
+		recordEnd = data.size();
+		inRecord = false;
+		error = false;
+		return true;
+	}
+	template<typename T>
+	void get(T* value) {
+		if (pos + sizeof(T) > recordEnd) {
+			if (!inRecord) {
+				error = true;
+			}
+			pos = recordEnd;
+			return;
+		}
+		memcpy(value, &data[pos], sizeof(T));
+		pos += sizeof(T);
+	}
+	void getBytes(void* dest, size_t size) {
+		if (pos + size > recordEnd) {
+			if (!inRecord) {
+				error = true;
+			}
+			pos = recordEnd;
+			return;
+		}
+		memcpy(dest, &data[pos], size);
+		pos += size;
+	}
+	bool openRecord() {
+		uint16_t size = 0;
+		get(&size);
+		if (error || pos + size > data.size()) {
+			error = true;
+			return false;
+		}
+		recordEnd = pos + size;
+		inRecord = true;
+		return true;
+	}
+	void closeRecord() {// also skips a record that was opened but not read
+		pos = recordEnd;
+		recordEnd = data.size();
+		inRecord = false;
+	}
+	bool checkRecords(int numRecords) {// true when the next numRecords records are all in the blob, so that reading them can't fail half way; doesn't move
+		size_t start = pos;
+		for (int i = 0; i < numRecords && !error; i++) {
+			if (openRecord()) {
+				closeRecord();
+			}
+		}
+		bool ok = !error;
+		pos = start;
+		error = false;
+		return ok;
+	}
+};
+
 
 
 //*****************************************************************************
@@ -101,6 +385,12 @@ struct GlobalConst {
 	static constexpr float defHPFCutoffFreq = 13.0f;
 	static constexpr float maxLPFCutoffFreq = 20000.0f;
 	static constexpr float defLPFCutoffFreq = 20010.0f;
+	static constexpr float dormantThreshold = 1e-5f;// in volts, a track whose input and pre-fader signals stay below this is silent
+	static constexpr float dormantDelay = 1.0f;// in seconds, a track that stays silent this long goes dormant
+	static constexpr float ecoAdaptiveMinSaving = 0.1f;// fraction of the divider-1 cost that a doubled control-rate divider must save to be kept by the adaptive eco
+	static constexpr int ecoAdaptiveHold = 16;// in light refresh periods, that the adaptive eco measures a control-rate divider for
+	static constexpr int ecoAdaptiveSettle = 4;// in light refresh periods, at the start of a hold, that are not measured (EcoMeter is still smoothing)
+	static constexpr int ecoAdaptiveRetryHold = 128;// in light refresh periods, before the adaptive eco tries again a divider that didn't save enough
 };
 
 
@@ -134,6 +424,7 @@ static inline float calcDimGainIntegerDB(float dimGain) {
 // Utility
 
 float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fadeGainXr, float timeStepX, float shape, bool symmetricalFade);
+simd::float_4 updateFadeGain(simd::float_4 fadeGain, simd::float_4 target, simd::float_4 *fadeGainX, simd::float_4 *fadeGainXr, simd::float_4 timeStepX, simd::float_4 shape, bool symmetricalFade);// four fades at once
 
 struct TrackSettingsCpBuffer {
 	// first level of copy paste (copy copy-paste of track settings)
@@ -171,8 +462,51 @@ struct TrackSettingsCpBuffer {
 };
 
 
-static inline bool isLinked(const unsigned long *linkBitMaskSrc, int index) {return (*linkBitMaskSrc & (1 << index)) != 0;}
-static inline void toggleLinked(unsigned long *linkBitMaskSrc, int index) {*linkBitMaskSrc ^= (1 << index);}
+// track and group bits of a mixer (links, solos, slow dirty): the tracks have their own 64-bit word so that a mixer can have 
+// up to 64 tracks, the groups are in the second word (followed by the aux and the master in slowDirty)
+// index is a track number, or numTracks + group number, as in the track and group params
+struct TrkGrpBits {
+	uint64_t trk = 0;// trk1 = lsb
+	uint64_t grp = 0;// grp1 = lsb
+	
+	bool test(int numTracks, int index) const {
+		return index < numTracks ? ((trk >> index) & 0x1) != 0 : ((grp >> (index - numTracks)) & 0x1) != 0;
+	}
+	void set(int numTracks, int index) {
+		if (index < numTracks) trk |= ((uint64_t)1 << index); else grp |= ((uint64_t)1 << (index - numTracks));
+	}
+	void clear(int numTracks, int index) {
+		if (index < numTracks) trk &= ~((uint64_t)1 << index); else grp &= ~((uint64_t)1 << (index - numTracks));
+	}
+	void toggle(int numTracks, int index) {
+		if (index < numTracks) trk ^= ((uint64_t)1 << index); else grp ^= ((uint64_t)1 << (index - numTracks));
+	}
+	void reset() {trk = 0; grp = 0;}
+	bool any() const {return (trk | grp) != 0;}
+	bool operator==(const TrkGrpBits &other) const {return trk == other.trk && grp == other.grp;}
+	bool operator!=(const TrkGrpBits &other) const {return !(*this == other);}
+};
+
+// all ones in the numBits lsbs, numBits can be 0 to 64
+static constexpr uint64_t lowBits64(int numBits) {return numBits <= 0 ? 0 : (~(uint64_t)0) >> (64 - numBits);}
+// shifts where the count can be 64 (for a mixer with 64 tracks), which gives 0
+static inline uint64_t shiftLeft64(uint64_t bits, int count) {return count >= 64 ? 0 : bits << count;}
+static inline uint64_t shiftRight64(uint64_t bits, int count) {return count >= 64 ? 0 : bits >> count;}
+
+
+// strips of a mixer to mark for updateSlowValues() from the ui thread (menus, knobs, cables, resets): the bits are or-ed into the
+// mixer's two request words (trk and grp words of slowDirty), which the engine thread moves into slowDirty at every sample
+struct SlowDirtyRequest {
+	std::atomic<uint64_t>* words = nullptr;// nullptr when there is nothing to mark
+	TrkGrpBits bits;
+	
+	void request() const {
+		if (words) {
+			if (bits.trk != 0) words[0].fetch_or(bits.trk, std::memory_order_release);
+			if (bits.grp != 0) words[1].fetch_or(bits.grp, std::memory_order_release);
+		}
+	}
+};
 
 
 //*****************************************************************************
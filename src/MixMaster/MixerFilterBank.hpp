@@ -0,0 +1,108 @@
+//***********************************************************************************************
+//Mixer module for VCV Rack by Steve Baker and Marc Boulé
+//
+//Based on code from the Fundamental plugin by Andrew Belt
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+
+// HPF and LPF of all the tracks and groups of a mixer, with two stereo channels per simd::float_4 (L R L R),
+// which matches the interleaving of the taps so that they can be loaded and stored directly.
+// Channels 0 to N_TRK-1 are the tracks, and N_TRK to N_TRK+N_GRP-1 are the groups.
+// Instead of branching, lanes whose filter is off (or in the other filter position, or the R lane of a mono track)
+// are masked: they keep their state and pass through, so results are bit-identical to the scalar filters.
+struct MixerFilterBank {
+	static const int N_QUAD = (N_TRK + N_GRP) / 2;
+	static const int GRP_QUAD = N_TRK / 2;// first quad of the groups
+
+	// Constants
+	// none
+
+	// need to save, no reset
+	// none
+
+	// need to save, with reset
+	// none
+
+	// no need to save, with reset (per channel)
+	ButterworthThirdOrderSimd hpFilters[N_QUAD];// 18dB/oct
+	ButterworthSecondOrderSimd lpFilters[N_QUAD];// 12db/oct
+
+	// no need to save, no reset
+	alignas(16) float hpfOns[N_QUAD * 4];// 1.0f when the lane's HPF is to be processed, 0.0f otherwise
+	alignas(16) float lpfOns[N_QUAD * 4];
+	alignas(16) float preInserts[N_QUAD * 4];// 1.0f when the channel's filters are before its inserts
+	alignas(16) float monos[N_QUAD * 4];// 1.0f in the R lane of a mono channel, whose R is copied from L when filtered
+
+
+	MixerFilterBank() {
+		for (int chan = 0; chan < N_TRK + N_GRP; chan++) {
+			setHpfCutoff(chan, 0.1f);
+			setLpfCutoff(chan, 0.4f);
+			setChannel(chan, false, false, true, false);
+		}
+	}
+
+
+	// the tracks and groups reset their own channels
+	void resetChannel(int chan) {
+		int l = (chan & 0x1) << 1;
+		for (int i = 0; i < 2; i++) {
+			hpFilters[chan >> 1].reset(l + i);
+			lpFilters[chan >> 1].reset(l + i);
+		}
+	}
+
+
+	void setHpfCutoff(int chan, float nfc) {// normalized freq
+		int l = (chan & 0x1) << 1;
+		hpFilters[chan >> 1].setParameters(l + 0, true, nfc);
+		hpFilters[chan >> 1].setParameters(l + 1, true, nfc);
+	}
+
+
+	void setLpfCutoff(int chan, float nfc) {// normalized freq
+		int l = (chan & 0x1) << 1;
+		lpFilters[chan >> 1].setParameters(l + 0, false, nfc);
+		lpFilters[chan >> 1].setParameters(l + 1, false, nfc);
+	}
+
+
+	void setChannel(int chan, bool hpfOn, bool lpfOn, bool stereo, bool preInsert) {
+		int i = chan << 1;
+		hpfOns[i + 0] = hpfOn ? 1.0f : 0.0f;
+		hpfOns[i + 1] = (hpfOn && stereo) ? 1.0f : 0.0f;
+		lpfOns[i + 0] = lpfOn ? 1.0f : 0.0f;
+		lpfOns[i + 1] = (lpfOn && stereo) ? 1.0f : 0.0f;
+		preInserts[i + 0] = preInsert ? 1.0f : 0.0f;
+		preInserts[i + 1] = preInserts[i + 0];
+		monos[i + 0] = 0.0f;
+		monos[i + 1] = stereo ? 0.0f : 1.0f;
+	}
+
+
+	// filters the interleaved stereo signals in sigs[], which hold the channels of quads firstQuad to firstQuad+numQuads-1
+	// only the channels whose filter position matches preInsert are filtered
+	void process(float* sigs, int firstQuad, int numQuads, bool preInsert) {
+		for (int q = firstQuad; q < firstQuad + numQuads; q++) {
+			int i = q << 2;
+			simd::float_4 preInsertLanes = simd::float_4::load(&preInserts[i]);
+			simd::float_4 posLanes = preInsert ? (preInsertLanes != 0.0f) : (preInsertLanes == 0.0f);
+			simd::float_4 hpMask = (simd::float_4::load(&hpfOns[i]) != 0.0f) & posLanes;
+			simd::float_4 lpMask = (simd::float_4::load(&lpfOns[i]) != 0.0f) & posLanes;
+			simd::float_4 onMask = hpMask | lpMask;
+			if (simd::movemask(onMask) == 0) {
+				continue;
+			}
+			float* sig = &sigs[(q - firstQuad) << 2];
+			simd::float_4 v = simd::float_4::load(sig);
+			v = hpFilters[q].process(v, hpMask);
+			v = lpFilters[q].process(v, lpMask);
+			// R of a mono channel is a copy of its filtered L
+			simd::float_4 dupL = simd::float_4(_mm_shuffle_ps(v.v, v.v, _MM_SHUFFLE(2, 2, 0, 0)));
+			simd::float_4 dupOnMask = simd::float_4(_mm_shuffle_ps(onMask.v, onMask.v, _MM_SHUFFLE(2, 2, 0, 0)));
+			simd::float_4 monoMask = (simd::float_4::load(&monos[i]) != 0.0f) & dupOnMask;
+			simd::ifelse(monoMask, dupL, v).store(sig);
+		}
+	}
+};// struct MixerFilterBank
@@ -56,6 +56,7 @@ struct DispColorItem : MenuItem {
 
 struct PanLawMonoItem : MenuItem {
 	int *panLawMonoSrc;
+	SlowDirtyRequest slowDirtyRequest;// strips whose slow values depend on this setting
 	const std::string panLawMonoNames[4] = {
 		"+0 dB (no compensation)", 
 		"+3 dB boost (equal power, default)", 
@@ -68,7 +69,8 @@ struct PanLawMonoItem : MenuItem {
 		for (int i = 0; i < 4; i++) {
 			menu->addChild(createCheckMenuItem(panLawMonoNames[i], "",
 				[=]() {return *panLawMonoSrc == i;},
-				[=]() {*panLawMonoSrc = i;}
+				[=]() {*panLawMonoSrc = i;
+					   slowDirtyRequest.request();}
 			));
 		}
 		return menu;
@@ -80,6 +82,7 @@ struct PanLawStereoItem : MenuItem {
 	int8_t *panLawStereoSrc;
 	bool isGlobal;// true when this is in the context menu of module, false when it is in a track/group context menu
 	GlobalToLocalOp* localOp;// must always set this up when isGlobal==true
+	SlowDirtyRequest slowDirtyRequest;// strips whose slow values depend on this setting
 	const std::string panLawStereoNames[4] = {
 		"Stereo balance linear",
 		"Stereo balance equal power (default)",
@@ -93,7 +96,8 @@ struct PanLawStereoItem : MenuItem {
 			menu->addChild(createCheckMenuItem(panLawStereoNames[i], "",
 				[=]() {return *panLawStereoSrc == i;},
 				[=]() {if (i == 3) localOp->setOp(GTOL_STEREOPAN, *panLawStereoSrc);
-					   *panLawStereoSrc = i;}
+					   *panLawStereoSrc = i;
+					   slowDirtyRequest.request();}
 			));
 		}
 		return menu;
@@ -226,12 +230,14 @@ struct MomentaryCvModeItem : MenuItem {
 struct AuxReturnItem : MenuItem {
 	int* auxReturnsMutedWhenMainSoloPtr;
 	int* auxReturnsSolosMuteDryPtr;
+	SlowDirtyRequest slowDirtyRequest;// strips whose slow values depend on this setting
 
 	Menu *createChildMenu() override {
 		Menu *menu = new Menu;
 		menu->addChild(createCheckMenuItem("Mute aux returns when soloing tracks", "",
 			[=]() {return *auxReturnsMutedWhenMainSoloPtr != 0;},
-			[=]() {*auxReturnsMutedWhenMainSoloPtr ^= 0x1;}
+			[=]() {*auxReturnsMutedWhenMainSoloPtr ^= 0x1;
+				   slowDirtyRequest.request();}
 		));
 		menu->addChild(createCheckMenuItem("Mute tracks when soloing aux returns", "",
 			[=]() {return *auxReturnsSolosMuteDryPtr != 0;},
@@ -371,15 +377,18 @@ struct GainAdjustQuantity : Quantity {
 	float *gainAdjustSrc;
 	float minDb;
 	float maxDb;
+	SlowDirtyRequest slowDirtyRequest;// nothing to mark when the gain is applied at every sample
 	  
-	GainAdjustQuantity(float *_gainAdjustSrc, float _minDb, float _maxDb) {
+	GainAdjustQuantity(float *_gainAdjustSrc, float _minDb, float _maxDb, SlowDirtyRequest _slowDirtyRequest) {
 		gainAdjustSrc = _gainAdjustSrc;
 		minDb = _minDb;
 		maxDb = _maxDb;
+		slowDirtyRequest = _slowDirtyRequest;
 	}
 	void setValue(float value) override {
 		float gainInDB = math::clamp(value, getMinValue(), getMaxValue());
 		*gainAdjustSrc = std::pow(10.0f, gainInDB / 20.0f);
+		slowDirtyRequest.request();
 	}
 	float getValue() override {
 		return 20.0f * std::log10(*gainAdjustSrc);
@@ -398,8 +407,8 @@ struct GainAdjustQuantity : Quantity {
 	std::string getUnit() override {return " dB";}
 };
 struct GainAdjustSlider : ui::Slider {
-	GainAdjustSlider(float *gainAdjustSrc, float minDb, float maxDb) {
-		quantity = new GainAdjustQuantity(gainAdjustSrc, minDb, maxDb);
+	GainAdjustSlider(float *gainAdjustSrc, float minDb, float maxDb, SlowDirtyRequest slowDirtyRequest = SlowDirtyRequest()) {
+		quantity = new GainAdjustQuantity(gainAdjustSrc, minDb, maxDb, slowDirtyRequest);
 	}
 	~GainAdjustSlider() {
 		delete quantity;
@@ -855,7 +864,12 @@ struct TrackReorderItem : MenuItem {
 			*trackMoveInAuxRequestPtr = (trackNumSrc | (trackNumDest << 8));
 			
 			// broadcast track move to message bus
-			mixerMessageBus.sendTrackMove((*idPtr) + 1, trackNumSrc, trackNumDest);
+			if (numTracks <= 16) {
+				mixerMessageBus.sendTrackMove((*idPtr) + 1, trackNumSrc, trackNumDest);
+			}
+			else {
+				mixerMessageBus.sendTrackMovePaged((*idPtr) + 1, trackNumSrc, trackNumDest);
+			}
 			
 			e.consume(this);// don't allow ctrl-click to keep menu open
 		}
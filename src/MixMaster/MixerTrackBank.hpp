@@ -0,0 +1,400 @@
+//***********************************************************************************************
+//Mixer module for VCV Rack by Steve Baker and Marc Boulé
+//
+//Based on code from the Fundamental plugin by Andrew Belt
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+
+// Audio-rate part of all the tracks of a mixer, with four tracks per simd::float_4 (structure of arrays).
+// Each MixerTrack still does its own control-rate work (fade target, fader, pan matrix) in processControl(),
+// except for the fades along the fade curves, which the bank does four tracks at a time,
+// as well as its inserts, and the bank does the rest: in gain, stereo width, filters (in the filter bank), gain matrix,
+// mute/solo gain and the summing into the mix and group busses.
+// Every operation is done per lane in the same order as the scalar track code, so results are bit-identical.
+// A connected track that stays silent for GlobalConst::dormantDelay goes dormant: its outputs are zero and it is skipped
+// by the filters, inserts, VU and mix, until the first sample of its input that is not silent, where it wakes.
+// While dormant, its slewers jump to their targets (there is no signal to pop), so it wakes with the right gains.
+struct MixerTrackBank {
+	static const int N_QUAD = N_TRK / 4;
+
+	// Constants
+	// none
+
+	// need to save, no reset
+	// none
+
+	// need to save, with reset
+	// none
+
+	// no need to save, with reset
+	alignas(16) float dormants[N_TRK];// 1.0f when track is dormant, 0.0f otherwise
+	alignas(16) float silentCounts[N_TRK];// number of consecutive silent samples
+	TSlewLimiterSingle<simd::float_4> inGainSlewers[N_QUAD];
+	TSlewLimiterSingle<simd::float_4> stereoWidthSlewers[N_QUAD];
+	TSlewLimiterSingle<simd::float_4> gainMatrixSlewers[4][N_QUAD];// [0] is L, [1] is R, [2] is RinL, [3] is LinR
+	TSlewLimiterSingle<simd::float_4> muteSoloGainSlewers[N_QUAD];
+
+	// no need to save, no reset
+	MixerTrack* tracks;
+	GlobalInfo *gInfo;
+	MixerFilterBank *filterBank;
+	float *taps;// trackTaps of the mixer (see MixerTrack::taps for layout)
+	alignas(16) float inL[N_TRK];// raw input voltages of each track, or zero when track unused
+	alignas(16) float inR[N_TRK];
+	alignas(16) float inUse[N_TRK];// 1.0f when track's input is connected, 0.0f otherwise
+	alignas(16) float actives[N_TRK];// 1.0f when track's input is connected and track is not dormant, 0.0f otherwise
+	alignas(16) float insertFrees[N_TRK];// 1.0f when nothing is connected to track's insert input (which could bring sound to a silent track)
+	alignas(16) float stereos[N_TRK];// 1.0f when stereo, 0.0f otherwise
+	alignas(16) float inGains[N_TRK];
+	alignas(16) float stereoWidths[N_TRK];
+	alignas(16) float gainMatrices[4][N_TRK];// transposed targets of the tracks' gainMatrix
+	alignas(16) float volCvs[N_TRK];
+	alignas(16) float muteSoloGains[N_TRK];
+	int fadingTracks[N_TRK];// scratch, track numbers of the tracks that are fading
+	alignas(16) float sigL[N_TRK];// scratch, de-interleaved taps
+	alignas(16) float sigR[N_TRK];
+
+
+	MixerTrackBank(MixerTrack* _tracks, GlobalInfo *_gInfo, MixerFilterBank *_filterBank, float* _taps) {
+		tracks = _tracks;
+		gInfo = _gInfo;
+		filterBank = _filterBank;
+		taps = _taps;
+		for (int q = 0; q < N_QUAD; q++) {
+			inGainSlewers[q].setRiseFall(simd::float_4(GlobalConst::antipopSlewFast)); // slew rate is in input-units per second (ex: V/s)
+			stereoWidthSlewers[q].setRiseFall(simd::float_4(GlobalConst::antipopSlewFast));
+			for (int m = 0; m < 4; m++) {
+				gainMatrixSlewers[m][q].setRiseFall(simd::float_4(GlobalConst::antipopSlewSlow));
+			}
+			muteSoloGainSlewers[q].setRiseFall(simd::float_4(GlobalConst::antipopSlewFast));
+		}
+		onReset();
+	}
+
+
+	void onReset() {
+		resetNonJson();
+	}
+
+
+	void resetNonJson() {
+		for (int trk = 0; trk < N_TRK; trk++) {
+			dormants[trk] = 0.0f;
+			silentCounts[trk] = 0.0f;
+		}
+		for (int q = 0; q < N_QUAD; q++) {
+			inGainSlewers[q].reset();
+			stereoWidthSlewers[q].reset();
+			for (int m = 0; m < 4; m++) {
+				gainMatrixSlewers[m][q].reset();
+			}
+			muteSoloGainSlewers[q].reset();
+		}
+	}
+
+
+	void resetLane(int trk) {
+		int q = trk >> 2;
+		int l = trk & 0x3;
+		dormants[trk] = 0.0f;
+		silentCounts[trk] = 0.0f;
+		inGainSlewers[q].out[l] = 0.0f;
+		stereoWidthSlewers[q].out[l] = 0.0f;
+		for (int m = 0; m < 4; m++) {
+			gainMatrixSlewers[m][q].out[l] = 0.0f;
+		}
+		muteSoloGainSlewers[q].out[l] = 0.0f;
+	}
+
+
+	// slewers keep their output in active lanes, jump to their target in dormant lanes, and are zeroed in unused lanes
+	static simd::float_4 maskSlewer(simd::float_4 out, simd::float_4 target, simd::float_4 activeMask, simd::float_4 dormantMask) {
+		return simd::ifelse(activeMask, out, simd::ifelse(dormantMask, target, 0.0f));
+	}
+
+
+	void enterDormant(int trk) {
+		// this sample is still processed normally, its outputs are zero from the next sample on
+		MixerTrack* track = &tracks[trk];
+		dormants[trk] = 1.0f;
+		silentCounts[trk] = 0.0f;
+		track->insertOuts[0] = 0.0f;
+		track->insertOuts[1] = 0.0f;
+		track->vu.reset();
+		filterBank->resetChannel(trk);
+	}
+
+
+	void processFades() {// only when eco
+		int numFading = 0;
+		for (int trk = 0; trk < N_TRK; trk++) {
+			if (tracks[trk].processFadeTarget()) {
+				fadingTracks[numFading++] = trk;
+			}
+		}
+		
+		for (int i = 0; i < numFading; i += 4) {
+			simd::float_4 fadeGain;
+			simd::float_4 target;
+			simd::float_4 fadeGainX;
+			simd::float_4 fadeGainXr;
+			simd::float_4 deltaX;
+			simd::float_4 fadeProfile;
+			for (int l = 0; l < 4; l++) {
+				// lanes past the last fading track repeat it, and are not written back
+				MixerTrack* track = &tracks[fadingTracks[std::min(i + l, numFading - 1)]];
+				fadeGain[l] = track->fadeGain;
+				target[l] = track->target;
+				fadeGainX[l] = track->fadeGainX;
+				fadeGainXr[l] = track->fadeGainXr;
+				deltaX[l] = (gInfo->sampleTime / *track->fadeRate) * (1 + gInfo->ecoMask);// last value is sub refresh
+				fadeProfile[l] = track->fadeProfile;
+			}
+			fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
+			for (int l = 0; l < 4 && i + l < numFading; l++) {
+				MixerTrack* track = &tracks[fadingTracks[i + l]];
+				track->fadeGain = fadeGain[l];
+				track->fadeGainX = fadeGainX[l];
+				track->fadeGainXr = fadeGainXr[l];
+				track->fadeGainScaled = powInt(track->fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
+			}
+		}
+	}
+
+
+	void process(float *mix, float *groupTaps, bool eco) {// all tracks
+		simd::float_4 sampleTime = simd::float_4(gInfo->sampleTime);
+
+		if (eco) {
+			processFades();
+		}
+
+		// Control rate, and gather of inputs and targets
+		for (int trk = 0; trk < N_TRK; trk++) {
+			MixerTrack* track = &tracks[trk];
+			track->processControl(eco);
+			if (track->bankResetRequest) {
+				resetLane(trk);
+				track->bankResetRequest = false;
+			}
+
+			// optimize unused track
+			if (!track->inSig[0].isConnected()) {
+				if (track->oldInUse) {
+					track->taps[0] = 0.0f; track->taps[1] = 0.0f;
+					track->taps[N_TRK * 2 + 0] = 0.0f; track->taps[N_TRK * 2 + 1] = 0.0f;
+					track->taps[N_TRK * 4 + 0] = 0.0f; track->taps[N_TRK * 4 + 1] = 0.0f;
+					track->taps[N_TRK * 6 + 0] = 0.0f; track->taps[N_TRK * 6 + 1] = 0.0f;
+					track->insertOuts[0] = 0.0f;
+					track->insertOuts[1] = 0.0f;
+					track->vu.reset();
+					resetLane(trk);
+					track->oldInUse = false;
+				}
+				inUse[trk] = 0.0f;
+				actives[trk] = 0.0f;
+				inL[trk] = 0.0f;
+				inR[trk] = 0.0f;
+				continue;
+			}
+			track->oldInUse = true;
+			inUse[trk] = 1.0f;
+
+			// Tap[0],[1]: pre-insert (inputs with gain adjust and stereo width)
+			Input* inSig = track->inSig;
+			if (track->stereo) {// either because R is connected, or polyStereo is active and L is a poly cable
+				if (inSig[1].isConnected()) {// if stereo because R connected
+					inL[trk] = inSig[0].getVoltageSum();
+					inR[trk] = inSig[1].getVoltageSum();
+				}
+				else {// here were are in polyStero mode, so take all odd numbered into L, even numbered into R (1-indexed)
+					sumPolyStereo(&inSig[0], &inL[trk], &inR[trk]);
+				}
+			}
+			else {
+				inL[trk] = inSig[0].getVoltageSum();
+				inR[trk] = inL[trk];
+			}
+			stereos[trk] = track->stereo ? 1.0f : 0.0f;
+			inGains[trk] = track->inGain;
+			stereoWidths[trk] = track->stereoWidth;
+			for (int m = 0; m < 4; m++) {
+				gainMatrices[m][trk] = track->gainMatrix[m];
+			}
+			volCvs[trk] = track->volCv;
+			muteSoloGains[trk] = track->fadeGainScaledWithSolo;
+			insertFrees[trk] = track->inInsert[trk >> 3].isConnected() ? 0.0f : 1.0f;
+			
+			// dormant track wakes on the first sample that is not silent
+			if (dormants[trk] != 0.0f) {
+				if (std::fabs(inL[trk]) >= GlobalConst::dormantThreshold || std::fabs(inR[trk]) >= GlobalConst::dormantThreshold || insertFrees[trk] == 0.0f) {
+					dormants[trk] = 0.0f;
+					silentCounts[trk] = 0.0f;
+				}
+			}
+			actives[trk] = 1.0f - dormants[trk];
+		}
+
+
+		// In gain and stereo width, four tracks at a time
+		for (int q = 0; q < N_QUAD; q++) {
+			int t4 = q << 2;
+			simd::float_4 activeMask = simd::float_4::load(&actives[t4]) != 0.0f;
+			simd::float_4 dormantMask = simd::float_4::load(&dormants[t4]) != 0.0f;
+			simd::float_4 inGainTarget = simd::float_4::load(&inGains[t4]);
+			simd::float_4 stereoWidthTarget = simd::float_4::load(&stereoWidths[t4]);
+			if (simd::movemask(activeMask) == 0) {
+				inGainSlewers[q].out = maskSlewer(inGainSlewers[q].out, inGainTarget, activeMask, dormantMask);
+				stereoWidthSlewers[q].out = maskSlewer(stereoWidthSlewers[q].out, stereoWidthTarget, activeMask, dormantMask);
+				simd::float_4::zero().store(&sigL[t4]);
+				simd::float_4::zero().store(&sigR[t4]);
+				continue;
+			}
+
+			// in Gain
+			inGainSlewers[q].process(sampleTime, inGainTarget);
+			inGainSlewers[q].out = maskSlewer(inGainSlewers[q].out, inGainTarget, activeMask, dormantMask);
+			simd::float_4 left = simd::float_4::load(&inL[t4]) * inGainSlewers[q].out;
+			simd::float_4 right = simd::float_4::load(&inR[t4]) * inGainSlewers[q].out;
+
+			// Stereo width
+			stereoWidthSlewers[q].process(sampleTime, stereoWidthTarget);
+			stereoWidthSlewers[q].out = maskSlewer(stereoWidthSlewers[q].out, stereoWidthTarget, activeMask, dormantMask);
+			simd::float_4 width = stereoWidthSlewers[q].out;
+			simd::float_4 wdiv2 = width * 0.5f;
+			simd::float_4 up = 0.5f + wdiv2;
+			simd::float_4 down = 0.5f - wdiv2;
+			simd::float_4 widthMask = (simd::float_4::load(&stereos[t4]) != 0.0f) & (width != 1.0f);
+			simd::float_4 leftW = left * up + right * down;
+			simd::float_4 rightW = right * up + left * down;
+			simd::ifelse(activeMask, simd::ifelse(widthMask, leftW, left), 0.0f).store(&sigL[t4]);
+			simd::ifelse(activeMask, simd::ifelse(widthMask, rightW, right), 0.0f).store(&sigR[t4]);
+		}
+		for (int trk = 0; trk < N_TRK; trk++) {
+			taps[(trk << 1) + 0] = clampNothing(sigL[trk]);
+			taps[(trk << 1) + 1] = clampNothing(sigR[trk]);
+		}
+
+
+		// Tap[32],[33]: pre-fader (inserts and filters), all filters of a position are done in one pass of the filter bank
+		for (int trk = 0; trk < N_TRK; trk++) {
+			MixerTrack* track = &tracks[trk];
+			if (actives[trk] != 0.0f) {
+				filterBank->setChannel(trk, track->getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq, track->getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq, track->stereo, !track->isFilterPostInsert());
+			}
+			else {
+				filterBank->setChannel(trk, false, false, true, false);
+			}
+		}
+		memcpy(&taps[N_TRK * 2], &taps[0], N_TRK * 2 * 4);
+		filterBank->process(&taps[N_TRK * 2], 0, N_TRK / 2, true);// filters pre-insert
+		for (int trk = 0; trk < N_TRK; trk++) {
+			if (actives[trk] != 0.0f) {
+				tracks[trk].processInserts();
+			}
+		}
+		filterBank->process(&taps[N_TRK * 2], 0, N_TRK / 2, false);// filters post-insert
+
+
+		// Tap[64],[65]: post-fader (pan and fader) and Tap[96],[97]: post-mute-solo, four tracks at a time
+		for (int trk = 0; trk < N_TRK; trk++) {
+			sigL[trk] = taps[N_TRK * 2 + (trk << 1) + 0];
+			sigR[trk] = taps[N_TRK * 2 + (trk << 1) + 1];
+		}
+		bool linearVolCvs = gInfo->directOutPanStereoMomentCvLinearVol.cc4[3] != 0;
+		alignas(16) float postFadL[N_TRK];
+		alignas(16) float postFadR[N_TRK];
+		float dormantDelay = gInfo->dormantDelaySamples;
+		for (int q = 0; q < N_QUAD; q++) {
+			int t4 = q << 2;
+			simd::float_4 activeMask = simd::float_4::load(&actives[t4]) != 0.0f;
+			simd::float_4 dormantMask = simd::float_4::load(&dormants[t4]) != 0.0f;
+			simd::float_4 muteSoloGainTarget = simd::float_4::load(&muteSoloGains[t4]);
+			if (simd::movemask(activeMask) == 0) {
+				for (int m = 0; m < 4; m++) {
+					gainMatrixSlewers[m][q].out = maskSlewer(gainMatrixSlewers[m][q].out, simd::float_4::load(&gainMatrices[m][t4]), activeMask, dormantMask);
+				}
+				muteSoloGainSlewers[q].out = maskSlewer(muteSoloGainSlewers[q].out, muteSoloGainTarget, activeMask, dormantMask);
+				simd::float_4::zero().store(&postFadL[t4]);
+				simd::float_4::zero().store(&postFadR[t4]);
+				simd::float_4::zero().store(&sigL[t4]);
+				simd::float_4::zero().store(&sigR[t4]);
+				continue;
+			}
+			simd::float_4 left = simd::float_4::load(&sigL[t4]);
+			simd::float_4 right = simd::float_4::load(&sigR[t4]);
+
+			// Silence detection (on input and pre-fader signals, so that filter tails and insert returns are included)
+			simd::float_4 inMax = simd::fmax(simd::fabs(simd::float_4::load(&inL[t4])), simd::fabs(simd::float_4::load(&inR[t4])));
+			simd::float_4 preFadMax = simd::fmax(simd::fabs(left), simd::fabs(right));
+			simd::float_4 silentMask = (simd::fmax(inMax, preFadMax) < GlobalConst::dormantThreshold) & (simd::float_4::load(&insertFrees[t4]) != 0.0f) & activeMask;
+			simd::float_4 silentCount = simd::ifelse(silentMask, simd::float_4::load(&silentCounts[t4]) + 1.0f, 0.0f);
+			silentCount.store(&silentCounts[t4]);
+			if (simd::movemask(silentCount >= dormantDelay) != 0) {
+				for (int l = 0; l < 4; l++) {
+					if (silentCounts[t4 + l] >= dormantDelay) {
+						enterDormant(t4 + l);
+					}
+				}
+			}
+
+			// Apply gainMatrix
+			for (int m = 0; m < 4; m++) {
+				simd::float_4 gainMatrixTarget = simd::float_4::load(&gainMatrices[m][t4]);
+				gainMatrixSlewers[m][q].process(sampleTime, gainMatrixTarget);
+				gainMatrixSlewers[m][q].out = maskSlewer(gainMatrixSlewers[m][q].out, gainMatrixTarget, activeMask, dormantMask);
+			}
+			simd::float_4 postL = left * gainMatrixSlewers[0][q].out + right * gainMatrixSlewers[2][q].out;
+			simd::float_4 postR = right * gainMatrixSlewers[1][q].out + left * gainMatrixSlewers[3][q].out;
+			if (linearVolCvs) {
+				simd::float_4 volCv = simd::float_4::load(&volCvs[t4]);
+				postL *= volCv;
+				postR *= volCv;
+			}
+			postL = simd::ifelse(activeMask, postL, 0.0f);
+			postR = simd::ifelse(activeMask, postR, 0.0f);
+			postL.store(&postFadL[t4]);
+			postR.store(&postFadR[t4]);
+
+			// Calc muteSoloGainSlewed
+			muteSoloGainSlewers[q].process(sampleTime, muteSoloGainTarget);
+			muteSoloGainSlewers[q].out = maskSlewer(muteSoloGainSlewers[q].out, muteSoloGainTarget, activeMask, dormantMask);
+			(postL * muteSoloGainSlewers[q].out).store(&sigL[t4]);
+			(postR * muteSoloGainSlewers[q].out).store(&sigR[t4]);
+		}
+		for (int trk = 0; trk < N_TRK; trk++) {
+			taps[N_TRK * 4 + (trk << 1) + 0] = postFadL[trk];
+			taps[N_TRK * 4 + (trk << 1) + 1] = postFadR[trk];
+			taps[N_TRK * 6 + (trk << 1) + 0] = sigL[trk];
+			taps[N_TRK * 6 + (trk << 1) + 1] = sigR[trk];
+		}
+
+
+		// Add to final mix or group, and VUs
+		bool cloaked = gInfo->colorAndCloak.cc4[cloakedMode] != 0;
+		for (int trk = 0; trk < N_TRK; trk++) {
+			if (actives[trk] == 0.0f) {
+				continue;
+			}
+			MixerTrack* track = &tracks[trk];
+			if (track->paGroup->getValue() < 0.5f) {
+				mix[0] += sigL[trk];
+				mix[1] += sigR[trk];
+			}
+			else {
+				int groupIndex = (int)(track->paGroup->getValue() - 0.5f);
+				groupTaps[(groupIndex << 1) + 0] += sigL[trk];
+				groupTaps[(groupIndex << 1) + 1] += sigR[trk];
+			}
+
+			// VUs
+			if (cloaked) {
+				track->vu.reset();
+			}
+			else if (eco) {
+				gInfo->vuBank.add(&track->vu, &track->taps[N_TRK * (track->fadeGainScaledWithSolo == 0.0f ? 4 : 6) + 0]);
+			}
+		}
+	}
+};// struct MixerTrackBank
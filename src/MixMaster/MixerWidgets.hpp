@@ -20,6 +20,12 @@ struct FilterCutWidget : ParamWidget {
 };
 
 struct HPFCutoffParamQuantity : ParamQuantity {
+	SlowDirtyRequest slowDirtyRequest;// the mixer strip of the knob, set by the mixer after config
+	
+	void setValue(float value) override {
+		ParamQuantity::setValue(value);
+		slowDirtyRequest.request();
+	}
 	std::string getDisplayValueString() override {
 		float valCut = getValue();
 		if (valCut >= GlobalConst::minHPFCutoffFreq) {
@@ -40,6 +46,12 @@ struct HPFCutoffParamQuantity : ParamQuantity {
 	}
 };
 struct LPFCutoffParamQuantity : ParamQuantity {
+	SlowDirtyRequest slowDirtyRequest;// the mixer strip of the knob, set by the mixer after config
+	
+	void setValue(float value) override {
+		ParamQuantity::setValue(value);
+		slowDirtyRequest.request();
+	}
 	std::string getDisplayValueString() override {
 		float valCut = getValue();
 		if (valCut <= GlobalConst::maxLPFCutoffFreq) {
@@ -672,10 +684,11 @@ struct TrackDisplay : EditableDisplayBase {
 			
 			menu->addChild(createCheckMenuItem("Invert input", "",
 				[=]() {return srcTrack->invertInput != 0;},
-				[=]() {srcTrack->invertInput ^= 0x1;}
+				[=]() {srcTrack->invertInput ^= 0x1;
+					   srcTrack->gInfo->requestSlowDirty(trackNumSrc);}
 			));
 
-			GainAdjustSlider *trackGainAdjustSlider = new GainAdjustSlider(&(srcTrack->gainAdjust), -20.0f, 20.0f);
+			GainAdjustSlider *trackGainAdjustSlider = new GainAdjustSlider(&(srcTrack->gainAdjust), -20.0f, 20.0f, srcTrack->gInfo->slowDirtyRequest(trackNumSrc));
 			trackGainAdjustSlider->box.size.x = 200.0f;
 			menu->addChild(trackGainAdjustSlider);
 			
@@ -709,12 +722,13 @@ struct TrackDisplay : EditableDisplayBase {
 			menu->addChild(fadeProfSlider);
 			
 			menu->addChild(createCheckMenuItem("Link fader & fade (ctrl/cmd+click)", "",
-				[=]() {return isLinked(&(srcTrack->gInfo->linkBitMask), trackNumSrc);},
-				[=]() {toggleLinked(&(srcTrack->gInfo->linkBitMask), trackNumSrc);}
+				[=]() {return srcTrack->gInfo->isLinked(trackNumSrc);},
+				[=]() {srcTrack->gInfo->toggleLinked(trackNumSrc);}
 			));
 
 			PolyStereoItem *polySteItem = createMenuItem<PolyStereoItem>("Poly input behavior", RIGHT_ARROW);
 			polySteItem->polyStereoSrc = &(srcTrack->polyStereo);
+			polySteItem->onChange = [=]() {srcTrack->gInfo->requestSlowDirty(trackNumSrc);};
 			menu->addChild(polySteItem);
 
 			if (srcTrack->gInfo->directOutPanStereoMomentCvLinearVol.cc4[0] >= 4) {
@@ -742,6 +756,7 @@ struct TrackDisplay : EditableDisplayBase {
 				PanLawStereoItem *panLawStereoItem = createMenuItem<PanLawStereoItem>("Stereo pan mode", RIGHT_ARROW);
 				panLawStereoItem->panLawStereoSrc = &(srcTrack->panLawStereo);
 				panLawStereoItem->isGlobal = false;
+				panLawStereoItem->slowDirtyRequest = srcTrack->gInfo->slowDirtyRequest(trackNumSrc);
 				menu->addChild(panLawStereoItem);
 			}
 
@@ -865,8 +880,8 @@ struct GroupDisplay : EditableDisplayBase {
 			
 			int groupNumForLink = numTracks + srcGroup->groupNum;
 			menu->addChild(createCheckMenuItem("Link fader & fade (ctrl/cmd+click)", "",
-				[=]() {return isLinked(&(srcGroup->gInfo->linkBitMask), groupNumForLink);},
-				[=]() {toggleLinked(&(srcGroup->gInfo->linkBitMask), groupNumForLink);}
+				[=]() {return srcGroup->gInfo->isLinked(groupNumForLink);},
+				[=]() {srcGroup->gInfo->toggleLinked(groupNumForLink);}
 			));
 
 			if (srcGroup->gInfo->directOutPanStereoMomentCvLinearVol.cc4[0] >= 4) {
@@ -894,6 +909,7 @@ struct GroupDisplay : EditableDisplayBase {
 				PanLawStereoItem *panLawStereoItem = createMenuItem<PanLawStereoItem>("Stereo pan mode", RIGHT_ARROW);
 				panLawStereoItem->panLawStereoSrc = &(srcGroup->panLawStereo);
 				panLawStereoItem->isGlobal = false;
+				panLawStereoItem->slowDirtyRequest = srcGroup->gInfo->slowDirtyRequest(groupNumForLink);
 				menu->addChild(panLawStereoItem);
 			}
 
@@ -1181,7 +1197,8 @@ struct MmMuteFadeButtonWithClear : MmMuteFadeButton {
 // --------------------
 
 struct MmSmallFaderWithLink : MmSmallFader {
-	unsigned long* linkBitMaskSrc;
+	TrkGrpBits* linkBitMaskSrc;
+	int numTracks;// used to find the groups in linkBitMask
 	int baseFaderParamId;
 	
 	void onButton(const event::Button &e) override {
@@ -1189,12 +1206,12 @@ struct MmSmallFaderWithLink : MmSmallFader {
 		int faderIndex = paramQuantity->paramId - baseFaderParamId;
 		if (e.button == GLFW_MOUSE_BUTTON_LEFT && e.action == GLFW_PRESS) {
 			if ((APP->window->getMods() & RACK_MOD_MASK) == RACK_MOD_CTRL) {
-				toggleLinked(linkBitMaskSrc, faderIndex);
+				linkBitMaskSrc->toggle(numTracks, faderIndex);
 				e.consume(this);
 				return;
 			}
 			else if ((APP->window->getMods() & RACK_MOD_MASK) == (RACK_MOD_CTRL | GLFW_MOD_SHIFT)) {
-				*linkBitMaskSrc = 0;
+				linkBitMaskSrc->reset();
 				e.consume(this);
 				return;
 			}
@@ -1207,7 +1224,7 @@ struct MmSmallFaderWithLink : MmSmallFader {
 			const ParamQuantity* paramQuantity = getParamQuantity();
 			if (paramQuantity) {
 				int faderIndex = paramQuantity->paramId - baseFaderParamId;
-				if (isLinked(linkBitMaskSrc, faderIndex)) {
+				if (linkBitMaskSrc->test(numTracks, faderIndex)) {
 					// float v = paramQuantity->getScaledValue();
 					float offsetY = handle->box.size.y / 2.0f;
 					// float ypos = math::rescale(v, 0.f, 1.f, minHandlePos.y, maxHandlePos.y) + offsetY;
@@ -11,15 +11,17 @@
 #pragma once
 
 #include <string>
-#include <vector>
-#include <mutex>
-#include <unordered_map>
+#include <atomic>
+#include <cstring>
 #include <cstdint>
 
 
+
 struct MessageBase {
 	int64_t id;
 	char name[7] = {};
+	int8_t trackPage = 0;// mixers with more than 16 tracks send each 16 tracks as their own member (page), see pageKey()
+	int8_t numTrackPages = 1;
 };
 
 struct MixerMessage : MessageBase {
@@ -37,92 +39,195 @@ struct MixerMessage : MessageBase {
 };
 
 
+// Lock-free bus: each member has a fixed slot with a seqlock, so that no thread ever waits on a mutex and nothing is allocated.
+// Writers (GUI thread, and engine thread when a mixer is added) update a slot between two increments of its sequence number,
+// and readers copy a slot until they get a copy with the same even sequence number before and after.
 struct MixerMessageBus {
-	std::mutex memberMutex;
-	std::unordered_map<int64_t, MixerMessage> memberData;// first value is a "Module::id + 1" (so that 0 = deregistered, instead of -1)
-
-
-	void send(int64_t id, const char* masterLabel, const char* trackLabels, const char* auxLabels, const int8_t *_vuColors, const int8_t *_dispColors, bool doTrackMoveInit) {
-		std::lock_guard<std::mutex> lock(memberMutex);
-		memberData[id].id = id;
-		memcpy(memberData[id].name, masterLabel, 6);
-		memberData[id].isJr = false;
-		memcpy(memberData[id].trkGrpAuxLabels, trackLabels, (16 + 4) * 4);// grabs groups also since contiguous
-		memcpy(&memberData[id].trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
-		memberData[id].vuColors[0] = _vuColors[0];
+	static const int MAX_MEMBERS = 128;
+
+	struct Member {
+		std::atomic<int64_t> key{0};// "Module::id + 1" of the member that uses this slot, 0 when free
+		std::atomic<uint32_t> seq{0};// odd while the data is being written
+		MixerMessage data;
+	};
+	Member members[MAX_MEMBERS];
+
+
+	Member* findMember(int64_t id) {
+		for (int i = 0; i < MAX_MEMBERS; i++) {
+			if (members[i].key.load(std::memory_order_acquire) == id) {
+				return &members[i];
+			}
+		}
+		return nullptr;
+	}
+	Member* findOrAddMember(int64_t id) {// nullptr when the bus is full
+		Member* member = findMember(id);
+		for (int i = 0; i < MAX_MEMBERS && member == nullptr; i++) {
+			int64_t freeKey = 0;
+			if (members[i].key.compare_exchange_strong(freeKey, id, std::memory_order_acq_rel)) {
+				member = &members[i];
+			}
+		}
+		return member;
+	}
+	
+	MixerMessage* beginWrite(Member* member) {
+		uint32_t seq = member->seq.load(std::memory_order_relaxed);
+		do {
+			while (seq & 0x1) {// another writer on the same member
+				seq = member->seq.load(std::memory_order_relaxed);
+			}
+		} while (!member->seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire));
+		std::atomic_thread_fence(std::memory_order_release);
+		return &member->data;
+	}
+	void endWrite(Member* member) {
+		member->seq.fetch_add(1, std::memory_order_release);
+	}
+	
+	void read(const Member* member, void* dest, size_t size) {// copies the first size bytes of the member's data
+		while (true) {
+			uint32_t seq = member->seq.load(std::memory_order_acquire);
+			if ((seq & 0x1) == 0) {
+				memcpy(dest, &member->data, size);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (member->seq.load(std::memory_order_relaxed) == seq) {
+					return;
+				}
+			}
+		}
+	}
+
+
+	// key of a page of a mixer's tracks: page 0 is the id, the others are negative (up to 4 pages, for 64 tracks)
+	static int64_t pageKey(int64_t id, int page) {
+		return page == 0 ? id : -((id << 2) | page);
+	}
+
+
+	void send(int64_t id, const char* masterLabel, const char* trackLabels, const char* auxLabels, const int8_t *_vuColors, const int8_t *_dispColors, bool doTrackMoveInit, int8_t trackPage = 0, int8_t numTrackPages = 1) {
+		// id is pageKey(id, trackPage) when the mixer has more than 16 tracks, and trackLabels has the 16 tracks of that page then the groups
+		Member* member = findOrAddMember(id);
+		if (!member) {
+			return;
+		}
+		MixerMessage* data = beginWrite(member);
+		data->id = id;
+		memcpy(data->name, masterLabel, 6);
+		data->trackPage = trackPage;
+		data->numTrackPages = numTrackPages;
+		data->isJr = false;
+		memcpy(data->trkGrpAuxLabels, trackLabels, (16 + 4) * 4);// grabs groups also since contiguous
+		memcpy(&data->trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
+		data->vuColors[0] = _vuColors[0];
 		if (_vuColors[0] >= 5) {
-			memcpy(&memberData[id].vuColors[1], &_vuColors[1], 16 + 4 + 4);
+			memcpy(&data->vuColors[1], &_vuColors[1], 16 + 4 + 4);
 		}
-		memberData[id].dispColors[0] = _dispColors[0];
+		data->dispColors[0] = _dispColors[0];
 		if (_dispColors[0] >= 7) {
-			memcpy(&memberData[id].dispColors[1], &_dispColors[1], 16 + 4 + 4);
+			memcpy(&data->dispColors[1], &_dispColors[1], 16 + 4 + 4);
 		}
 		if (doTrackMoveInit) {
-			memberData[id].tm.tmTot = 0;
+			data->tm.tmTot = 0;
 		}
+		endWrite(member);
 	}
 	void sendJr(int64_t id, const char* masterLabel, const char* trackLabels, const char* groupLabels, const char* auxLabels, const int8_t *_vuColors, const int8_t *_dispColors, bool doTrackMoveInit) {// does not write to tracks 9-16 and groups 3-4 when jr.
-		std::lock_guard<std::mutex> lock(memberMutex);
-		memberData[id].id = id;
-		memcpy(memberData[id].name, masterLabel, 6);
-		memberData[id].isJr = true;
-		memcpy(memberData[id].trkGrpAuxLabels, trackLabels, 8 * 4);
-		memcpy(&memberData[id].trkGrpAuxLabels[16 * 4], groupLabels, 2 * 4);
-		memcpy(&memberData[id].trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
-		memberData[id].vuColors[0] = _vuColors[0];
+		Member* member = findOrAddMember(id);
+		if (!member) {
+			return;
+		}
+		MixerMessage* data = beginWrite(member);
+		data->id = id;
+		memcpy(data->name, masterLabel, 6);
+		data->isJr = true;
+		memcpy(data->trkGrpAuxLabels, trackLabels, 8 * 4);
+		memcpy(&data->trkGrpAuxLabels[16 * 4], groupLabels, 2 * 4);
+		memcpy(&data->trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
+		data->vuColors[0] = _vuColors[0];
 		if (_vuColors[0] >= 5) {
-			memcpy(&memberData[id].vuColors[1], &_vuColors[1], 8);
-			memcpy(&memberData[id].vuColors[1 + 16], &_vuColors[1 + 16], 2);
-			memcpy(&memberData[id].vuColors[1 + 16 + 4], &_vuColors[1 + 16 + 4], 4);
+			memcpy(&data->vuColors[1], &_vuColors[1], 8);
+			memcpy(&data->vuColors[1 + 16], &_vuColors[1 + 16], 2);
+			memcpy(&data->vuColors[1 + 16 + 4], &_vuColors[1 + 16 + 4], 4);
 		}
-		memberData[id].dispColors[0] = _dispColors[0];
+		data->dispColors[0] = _dispColors[0];
 		if (_dispColors[0] >= 7) {
-			memcpy(&memberData[id].dispColors[1], &_dispColors[1], 8);
-			memcpy(&memberData[id].dispColors[1 + 16], &_dispColors[1 + 16], 2);
-			memcpy(&memberData[id].dispColors[1 + 16 + 4], &_dispColors[1 + 16 + 4], 4);
+			memcpy(&data->dispColors[1], &_dispColors[1], 8);
+			memcpy(&data->dispColors[1 + 16], &_dispColors[1 + 16], 2);
+			memcpy(&data->dispColors[1 + 16 + 4], &_dispColors[1 + 16 + 4], 4);
 		}
 		if (doTrackMoveInit) {
-			memberData[id].tm.tmTot = 0;
+			data->tm.tmTot = 0;
 		}
+		endWrite(member);
 	}
 	
 	void sendTrackMove(int64_t id, int8_t srcTrack, int8_t destTrack) {
-		std::lock_guard<std::mutex> lock(memberMutex);
+		Member* member = findOrAddMember(id);
+		if (!member) {
+			return;
+		}
+		MixerMessage* data = beginWrite(member);
 		// not need to write id since that is already there (MixMaster construct has sendToMessageBus() which has send(...))
-		memberData[id].tm.tmSep[0] = 1;
-		memberData[id].tm.tmSep[1] = srcTrack;
-		memberData[id].tm.tmSep[2] = destTrack;
-		memberData[id].tm.tmSep[3]++;
-		if (memberData[id].tm.tmSep[3] > 15) {
-			memberData[id].tm.tmSep[3] = 0;
+		data->tm.tmSep[0] = 1;
+		data->tm.tmSep[1] = srcTrack;
+		data->tm.tmSep[2] = destTrack;
+		data->tm.tmSep[3]++;
+		if (data->tm.tmSep[3] > 15) {
+			data->tm.tmSep[3] = 0;
+		}
+		endWrite(member);
+	}
+	void sendTrackMovePaged(int64_t id, int srcTrack, int destTrack) {
+		// tracks of the same page move within it; otherwise every page from the source's to the destination's shifts by one,
+		// but the settings of the tracks that cross a page boundary can't go from one listener to the other, so they are swapped
+		int srcPage = srcTrack >> 4;
+		int destPage = destTrack >> 4;
+		if (srcPage == destPage) {
+			sendTrackMove(pageKey(id, srcPage), srcTrack & 0xF, destTrack & 0xF);
+		}
+		else if (srcPage < destPage) {
+			for (int page = srcPage; page <= destPage; page++) {
+				sendTrackMove(pageKey(id, page), page == srcPage ? (srcTrack & 0xF) : 0, page == destPage ? (destTrack & 0xF) : 15);
+			}
+		}
+		else {
+			for (int page = destPage; page <= srcPage; page++) {
+				sendTrackMove(pageKey(id, page), page == srcPage ? (srcTrack & 0xF) : 15, page == destPage ? (destTrack & 0xF) : 0);
+			}
 		}
 	}
 
 	void receive(MixerMessage* message) {// id of sender we want to receive from must be in message->id, other fields will be filled by this method as the receive mechanism. If non-existing sender is requested, a blank message with an id of 0 will be returned
-		std::lock_guard<std::mutex> lock(memberMutex);
-		int64_t id = message->id;
-		*message = memberData[id];
+		Member* member = findMember(message->id);
+		if (!member) {
+			*message = MixerMessage();
+			return;
+		}
+		read(member, message, sizeof(MixerMessage));
 	}
 
 
-	std::vector<MessageBase>* surveyValues() {// caller must delete returned value when non null. Does not use MixerMessage type since don't want all the data, just the header info (id and name)
-		std::lock_guard<std::mutex> lock(memberMutex);
-
-		std::vector<MessageBase> *data = new std::vector<MessageBase>();
-		for (const auto &e : memberData) {
-			if (e.second.id != 0) {
-				MessageBase newMessage;
-				newMessage.id = e.second.id;
-				memcpy(newMessage.name, e.second.name, 6);
-				data->push_back(newMessage);
+	int surveyValues(MessageBase* dest) {// dest must have room for MAX_MEMBERS, returns the number of members written to dest. Does not use MixerMessage type since don't want all the data, just the header info (id and name)
+		int numMembers = 0;
+		for (int i = 0; i < MAX_MEMBERS; i++) {
+			if (members[i].key.load(std::memory_order_acquire) != 0) {
+				read(&members[i], &dest[numMembers], sizeof(MessageBase));// header is at the start of the data
+				if (dest[numMembers].id != 0) {
+					numMembers++;
+				}
 			}
 		}
-
-		return data;
+		return numMembers;
 	}
 
 	void deregisterMember(int64_t id) {
-		std::lock_guard<std::mutex> lock(memberMutex);
-		memberData.erase(id);
+		Member* member = findMember(id);
+		if (member) {
+			*beginWrite(member) = MixerMessage();
+			endWrite(member);
+			member->key.store(0, std::memory_order_release);
+		}
 	}
 };
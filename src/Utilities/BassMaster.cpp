@@ -201,16 +201,7 @@ struct BassMaster : Module {
 		bool polyStereo = miscSettings.cc4[1] != 0 && !inputs[IN_INPUTS + 1].isConnected() && inputs[IN_INPUTS + 0].isPolyphonic();
 		if (polyStereo) {
 			// here were are in polyStero mode, so take all odd numbered into L, even numbered into R (1-indexed)
-			inLeft = 0.0f;
-			inRight = 0.0f;
-			for (int c = 0; c < inputs[IN_INPUTS + 0].getChannels(); c++) {
-				if ((c & 0x1) == 0) {// if L channels (odd channels when 1-indexed)
-					inLeft += inputs[IN_INPUTS + 0].getVoltage(c);
-				}
-				else {
-					inRight += inputs[IN_INPUTS + 0].getVoltage(c);
-				}
-			}
+			sumPolyStereo(&inputs[IN_INPUTS + 0], &inLeft, &inRight);
 		}
 		else {
 			inLeft = inputs[IN_INPUTS + 0].getVoltageSum();
@@ -62,6 +62,40 @@ struct VuMeterAllDual {
 };
 
 
+// Processing of all the VuMeterAllDual of a module at once: meters are added with their L and R values as the
+// module's sections are processed, and all are processed together at the end. The four vuValues of a meter
+// are the four lanes of a simd::float_4, so each meter is one branch-free step (same results as VuMeterAllDual::process()).
+// The meters keep their vuValues, so the VuMeterBase::srcLevels pointers that the displays draw from are unchanged.
+template<int N>
+struct VuMeterBank {
+	int numVus = 0;
+	VuMeterAllDual* vus[N];
+	alignas(16) float values[N][4];// L, R, L, R of the signal of each added meter
+
+	void add(VuMeterAllDual* vu, const float *_values) {// L and R
+		vus[numVus] = vu;
+		values[numVus][0] = _values[0];
+		values[numVus][1] = _values[1];
+		values[numVus][2] = _values[0];
+		values[numVus][3] = _values[1];
+		numVus++;
+	}
+
+	void process(float deltaTime) {// all meters added since last call
+		const simd::float_4 peakLanes = simd::float_4(0.0f, 0.0f, 1.0f, 1.0f) == 0.0f;// lanes ordered as VuIds
+		for (int i = 0; i < numVus; i++) {
+			simd::float_4 in = simd::float_4::load(values[i]);
+			simd::float_4 x = simd::ifelse(peakLanes, simd::fabs(in), in * in);
+			simd::float_4 vu = simd::float_4::load(vus[i]->vuValues);
+			vu += (x - vu) * VuMeterAllDual::lambda * deltaTime;
+			// peak follower jumps up to a new peak and decays otherwise, which is the max of the two since lambda * deltaTime < 1
+			simd::ifelse(peakLanes, simd::fmax(x, vu), vu).store(vus[i]->vuValues);
+		}
+		numVus = 0;
+	}
+};
+
+
 
 // VuMeter displays (and colors)
 // ----------------------------------------------------------------------------
@@ -112,3 +112,85 @@ class ButterworthFourthOrder {
 		return f2.process(f1.process(in));
 	}
 };
+
+
+// Versions of the above with four independent filters on simd::float_4, each lane with its own cutoff (for filter banks)
+// Lanes that are off in the mask given to process() keep their state and pass their input through
+
+class ButterworthSecondOrderSimd {
+	simd::float_4 b[3] = {};// coefficients b0, b1 and b2
+	simd::float_4 a[3 - 1] = {};// coefficients a1 and a2
+	simd::float_4 x[3 - 1] = {};
+	simd::float_4 y[3 - 1] = {};
+	float midCoef = float(M_SQRT2);
+	
+	public:
+	
+	void setMidCoef(float _midCoef) {
+		midCoef = _midCoef;
+	}
+	
+	void reset() {
+		for (int i = 0; i < 2; i++) {
+			x[i] = 0.0f;
+			y[i] = 0.0f;
+		}
+	}
+	void reset(int lane) {
+		for (int i = 0; i < 2; i++) {
+			x[i][lane] = 0.0f;
+			y[i][lane] = 0.0f;
+		}
+	}
+
+	void setParameters(int lane, bool isHighPass, float nfc) {// normalized freq, same calculations as ButterworthSecondOrder
+		float nfcw = nfc < 0.025f ? float(M_PI) * nfc : std::tan(float(M_PI) * std::min(0.499f, nfc));
+		float acst = nfcw * nfcw + nfcw * midCoef + 1.0f;
+		a[0][lane] = 2.0f * (nfcw * nfcw - 1.0f) / acst;
+		a[1][lane] = (nfcw * nfcw - nfcw * midCoef + 1.0f) / acst;
+		float hbcst = 1.0f / acst;
+		float lbcst = hbcst * nfcw * nfcw;			
+		b[0][lane] = isHighPass ? hbcst : lbcst;
+		b[1][lane] = (isHighPass ? -hbcst : lbcst) * 2.0f;
+		b[2][lane] = b[0][lane];
+	}
+	
+	simd::float_4 process(simd::float_4 in, simd::float_4 mask) {
+		simd::float_4 out = b[0] * in + b[1] * x[0] + b[2] * x[1] - a[0] * y[0] - a[1] * y[1];
+		x[1] = simd::ifelse(mask, x[0], x[1]);
+		x[0] = simd::ifelse(mask, in, x[0]);
+		y[1] = simd::ifelse(mask, y[0], y[1]);
+		y[0] = simd::ifelse(mask, out, y[0]);
+		return simd::ifelse(mask, out, in);
+	}
+};
+
+
+class ButterworthThirdOrderSimd {
+	FirstOrderFilterSimd f1;
+	ButterworthSecondOrderSimd f2;
+	
+	public:
+	
+	ButterworthThirdOrderSimd() {
+		f2.setMidCoef(1.0f);
+	}
+	
+	void reset() {
+		f1.reset();
+		f2.reset();
+	}
+	void reset(int lane) {
+		f1.reset(lane);
+		f2.reset(lane);
+	}
+	
+	void setParameters(int lane, bool isHighPass, float nfc) {// normalized freq
+		f1.setParameters(lane, isHighPass, nfc);
+		f2.setParameters(lane, isHighPass, nfc);
+	}
+	
+	simd::float_4 process(simd::float_4 in, simd::float_4 mask) {
+		return f2.process(f1.process(in, mask), mask);
+	}
+};
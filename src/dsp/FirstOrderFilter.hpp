@@ -83,3 +83,40 @@ class FirstOrderStereoFilter : public FirstOrderCoefficients {
 		out[1] = y[1];
 	}
 };
+
+
+// Four independent filters on simd::float_4, each lane with its own cutoff (for filter banks)
+// Lanes that are off in the mask given to process() keep their state and pass their input through
+class FirstOrderFilterSimd {
+	simd::float_4 b[2] = {};// coefficients b0, b1
+	simd::float_4 a = 0.0f;// coefficient a1
+	simd::float_4 x = 0.0f;
+	simd::float_4 y = 0.0f;
+	
+	public: 
+	
+	void reset() {
+		x = 0.0f;
+		y = 0.0f;
+	}
+	void reset(int lane) {
+		x[lane] = 0.0f;
+		y[lane] = 0.0f;
+	}
+
+	void setParameters(int lane, bool isHighPass, float nfc) {// normalized freq, same calculations as FirstOrderCoefficients
+		float nfcw = nfc < 0.025f ? float(M_PI) * nfc : std::tan(float(M_PI) * std::min(0.499f, nfc));
+		a[lane] = (nfcw - 1.0f) / (nfcw + 1.0f);
+		float hbcst = 1.0f / (1.0f + nfcw);
+		float lbcst = 1.0f - hbcst;
+		b[0][lane] = isHighPass ? hbcst : lbcst;
+		b[1][lane] = isHighPass ? -hbcst : lbcst;
+	}
+
+	simd::float_4 process(simd::float_4 in, simd::float_4 mask) {
+		simd::float_4 out = b[0] * in + b[1] * x - a * y;
+		x = simd::ifelse(mask, in, x);
+		y = simd::ifelse(mask, out, y);
+		return simd::ifelse(mask, out, in);
+	}
+};
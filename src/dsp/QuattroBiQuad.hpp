@@ -17,6 +17,8 @@
 
 
 class QuattroBiQuadCoeff {
+	friend class QuattroTrackBiQuad;
+	
 	protected: 
 	
 	// coefficients
@@ -116,6 +118,49 @@ class QuattroBiQuadCoeff {
 	}
 
 
+	// Same as setParameters() for all four eqs at once (in one vector pass), where types[i] is the type of eq i
+	// All the cases of setParameters() have the form:
+	//   norm = 1 / (d0 + d1 * K / Q + d2 * K * K)
+	//   b0 = (n0 + n1 * K / Q + n2 * K * K) * norm,  b1 = 2 * (n2 * K * K - n0) * norm,  b2 = (n0 - n1 * K / Q + n2 * K * K) * norm
+	//   a1 = 2 * (d2 * K * K - d0) * norm,  a2 = (d0 - d1 * K / Q + d2 * K * K) * norm
+	// so only n0..d2 (and Q for the shelves) are chosen per eq, with ifelse
+	void setParametersVec(const Type* types, simd::float_4 nfc, simd::float_4 V, simd::float_4 Q) {
+		float lowShelf[4];
+		float highShelf[4];
+		for (int i = 0; i < 4; i++) {
+			lowShelf[i] = (types[i] == LOWSHELF ? 1.0f : 0.0f);
+			highShelf[i] = (types[i] == HIGHSHELF ? 1.0f : 0.0f);
+		}
+		simd::float_4 lowShelfMask = simd::float_4::load(lowShelf) != 0.0f;
+		simd::float_4 highShelfMask = simd::float_4::load(highShelf) != 0.0f;
+		simd::float_4 shelfMask = lowShelfMask | highShelfMask;
+		simd::float_4 boostMask = V >= 1.0f;
+		
+		simd::float_4 K = simd::ifelse(nfc < 0.025f, float(M_PI) * nfc, simd::tan(float(M_PI) * simd::fmin(0.499f, nfc)));
+		simd::float_4 sqrtV = simd::sqrt(V);
+		Q = simd::ifelse(shelfMask, simd::sqrt(Q) / float(M_SQRT2), Q);
+		
+		// boosts: low shelf n = (1, sqrtV, V), high shelf n = (V, sqrtV, 1), peak n = (1, V, 1), all with d = (1, 1, 1)
+		// cuts: n = (1, 1, 1), low shelf d = (1, 1/sqrtV, 1/V), high shelf d = (1/V, 1/sqrtV, 1), peak d = (1, 1/V, 1)
+		simd::float_4 invV = 1.0f / V;
+		simd::float_4 n0 = simd::ifelse(boostMask & highShelfMask, V, 1.0f);
+		simd::float_4 n1 = simd::ifelse(boostMask, simd::ifelse(shelfMask, sqrtV, V), 1.0f);
+		simd::float_4 n2 = simd::ifelse(boostMask & lowShelfMask, V, 1.0f);
+		simd::float_4 d0 = simd::ifelse(~boostMask & highShelfMask, invV, 1.0f);
+		simd::float_4 d1 = simd::ifelse(boostMask, 1.0f, simd::ifelse(shelfMask, 1.0f / sqrtV, invV));
+		simd::float_4 d2 = simd::ifelse(~boostMask & lowShelfMask, invV, 1.0f);
+		
+		simd::float_4 KoverQ = K / Q;
+		simd::float_4 KK = K * K;
+		simd::float_4 norm = 1.0f / (d0 + d1 * KoverQ + d2 * KK);
+		b0 = (n0 + n1 * KoverQ + n2 * KK) * norm;
+		b1 = 2.0f * (n2 * KK - n0) * norm;
+		b2 = (n0 - n1 * KoverQ + n2 * KK) * norm;
+		a1 = 2.0f * (d2 * KK - d0) * norm;
+		a2 = (d0 - d1 * KoverQ + d2 * KK) * norm;
+	}
+
+
 	// add all 4 values in return vector to get total gain (dB) since each float is gain (dB) of one biquad
 	simd::float_4 getFrequencyResponse(float f) {
 		// Compute sum(b_k z^-k) / sum(a_k z^-k) where z = e^(i s)
@@ -254,3 +299,244 @@ class QuattroBiQuad : public QuattroBiQuadCoeff {
 		out[1] = y0R[3];
 	}	
 };
+
+
+
+// Four stereo tracks, one per float_4 lane, each through its own four biquads in true series (no pipeline latency, 
+// unlike QuattroBiQuad), where each track's biquad parameters can be set separately
+class QuattroTrackBiQuad {
+	
+	// coefficients, bandCoeffs[b] holds band b of the four tracks (lane is track)
+	QuattroBiQuadCoeff bandCoeffs[4];
+	
+	// input/output shift registers, shared by the stages in series: [b] is the input of band b and the output of band b-1, 
+	// so [0] is the input and [4] is the output
+	simd::float_4 x1L[5], x1R[5];
+	simd::float_4 x2L[5], x2R[5];
+	
+	// coefficient ramps, see setParametersRamped()
+	QuattroBiQuadCoeff bandTargets[4];
+	QuattroBiQuadCoeff bandDeltas[4];// per sample increments towards bandTargets
+	int rampLength = 0;// in samples, 0 when ramps are off
+	int rampLeft = 0;// samples left in the current ramp, 0 at a ramp boundary
+	int8_t bandsRamping = 0;// 4 ls bits, one per band that has a lane in the current ramp
+	uint16_t targetGainsDifferentThanOne = 0;// gainsDifferentThanOne for when the current ramp is done
+	
+	// other
+	simd::float_4 outGains;// linear gain of each track, applied to the output of band 3
+	uint16_t gainsDifferentThanOne = 0;// bit (b << 2) + t is set when band b of track t has a gain, a band with none of its 4 bits set is bypassed
+	
+	
+	public:
+	
+	
+	QuattroTrackBiQuad() {
+		reset();
+	}
+	
+	
+	void reset() {
+		for (int b = 0; b < 5; b++) {
+			x1L[b] = 0.0f;
+			x1R[b] = 0.0f;
+			x2L[b] = 0.0f;
+			x2R[b] = 0.0f;
+		}
+		outGains = 1.0f;
+		gainsDifferentThanOne = 0xFFFF;
+		targetGainsDifferentThanOne = 0xFFFF;
+		rampLeft = 0;
+		bandsRamping = 0;
+	}
+	void reset(int t) {// one track only
+		for (int b = 0; b < 5; b++) {
+			x1L[b][t] = 0.0f;
+			x1R[b][t] = 0.0f;
+			x2L[b][t] = 0.0f;
+			x2R[b][t] = 0.0f;
+		}
+		outGains[t] = 1.0f;
+		gainsDifferentThanOne |= (0x1111 << t);
+		targetGainsDifferentThanOne |= (0x1111 << t);
+	}
+	
+	
+	void setOutGain(int t, float linearGain) {
+		outGains[t] = linearGain;
+	}
+	
+	
+	void setParameters(int t, int b, QuattroBiQuadCoeff::Type type, float f, float V, float Q) {
+		// t: track index (0 to 3)
+		// b: eq index (0 to 3)
+		// type: type of filter/eq
+		// f: normalized frequency (fc/sampleRate)
+		// V: linearGain for peak or shelving
+		// Q: quality factor
+		if (V == 1.0f) {
+			gainsDifferentThanOne &= ~(0x1 << ((b << 2) + t));
+			targetGainsDifferentThanOne &= ~(0x1 << ((b << 2) + t));
+		}
+		else {
+			gainsDifferentThanOne |= (0x1 << ((b << 2) + t));
+			targetGainsDifferentThanOne |= (0x1 << ((b << 2) + t));
+		}
+		bandCoeffs[b].QuattroBiQuadCoeff::setParameters(t, type, f, V, Q);
+		if ((bandsRamping & (1 << b)) != 0) {
+			// takes this lane out of the current ramp
+			setLane(&bandTargets[b], t, bandCoeffs[b], t);
+			setLane(&bandDeltas[b], t, 0.0f);
+		}
+	}
+	// same as setParameters(), with coefficients already calculated in lane srcI of src (by setParametersVec() for example)
+	void setCoefficients(int t, int b, const QuattroBiQuadCoeff& src, int srcI, float V) {
+		if (V == 1.0f) {
+			gainsDifferentThanOne &= ~(0x1 << ((b << 2) + t));
+			targetGainsDifferentThanOne &= ~(0x1 << ((b << 2) + t));
+		}
+		else {
+			gainsDifferentThanOne |= (0x1 << ((b << 2) + t));
+			targetGainsDifferentThanOne |= (0x1 << ((b << 2) + t));
+		}
+		setLane(&bandCoeffs[b], t, src, srcI);
+		if ((bandsRamping & (1 << b)) != 0) {
+			setLane(&bandTargets[b], t, src, srcI);
+			setLane(&bandDeltas[b], t, 0.0f);
+		}
+	}
+	
+	
+	// Modulated parameters: the exact coefficients are only computed at ramp boundaries (every rampLength samples), 
+	// and the coefficients are ramped linearly to them over the next rampLength samples. This is stability-safe since
+	// the stable region of (a1, a2) is a triangle (|a2| < 1, |a1| < 1 + a2), which is convex: every point on the 
+	// segment between two stable biquads is stable.
+	void setRampLength(int _rampLength) {
+		rampLength = _rampLength;
+	}
+	int getRampLength() {
+		return rampLength;
+	}
+	bool isRampBoundary() {
+		return rampLeft == 0;
+	}
+	void setParametersRamped(int t, int b, QuattroBiQuadCoeff::Type type, float f, float V, float Q) {
+		// same as setParameters(), but only to be called at a ramp boundary, when ramps are on
+		QuattroBiQuadCoeff target;
+		target.QuattroBiQuadCoeff::setParameters(t, type, f, V, Q);
+		setCoefficientsRamped(t, b, target, t, V);
+	}
+	void setCoefficientsRamped(int t, int b, const QuattroBiQuadCoeff& src, int srcI, float V) {
+		// same as setCoefficients(), but only to be called at a ramp boundary, when ramps are on
+		if (V == 1.0f) {
+			targetGainsDifferentThanOne &= ~(0x1 << ((b << 2) + t));
+		}
+		else {
+			targetGainsDifferentThanOne |= (0x1 << ((b << 2) + t));
+		}
+		gainsDifferentThanOne |= (0x1 << ((b << 2) + t));// keep the band processed during the ramp, even when its gain is ramping to 1
+		if ((bandsRamping & (1 << b)) == 0) {
+			// band's other lanes are not ramping
+			for (int ot = 0; ot < 4; ot++) {
+				if (ot != t) {
+					setLane(&bandTargets[b], ot, bandCoeffs[b], ot);
+					setLane(&bandDeltas[b], ot, 0.0f);
+				}
+			}
+			bandsRamping |= (1 << b);
+		}
+		setLane(&bandTargets[b], t, src, srcI);
+		float scale = 1.0f / (float)rampLength;
+		bandDeltas[b].b0[t] = (src.b0[srcI] - bandCoeffs[b].b0[t]) * scale;
+		bandDeltas[b].b1[t] = (src.b1[srcI] - bandCoeffs[b].b1[t]) * scale;
+		bandDeltas[b].b2[t] = (src.b2[srcI] - bandCoeffs[b].b2[t]) * scale;
+		bandDeltas[b].a1[t] = (src.a1[srcI] - bandCoeffs[b].a1[t]) * scale;
+		bandDeltas[b].a2[t] = (src.a2[srcI] - bandCoeffs[b].a2[t]) * scale;
+	}
+	
+	
+	private:
+	
+	static void setLane(QuattroBiQuadCoeff* dest, int t, const QuattroBiQuadCoeff& src, int srcT) {
+		dest->b0[t] = src.b0[srcT];
+		dest->b1[t] = src.b1[srcT];
+		dest->b2[t] = src.b2[srcT];
+		dest->a1[t] = src.a1[srcT];
+		dest->a2[t] = src.a2[srcT];
+	}
+	static void setLane(QuattroBiQuadCoeff* dest, int t, float value) {
+		dest->b0[t] = value;
+		dest->b1[t] = value;
+		dest->b2[t] = value;
+		dest->a1[t] = value;
+		dest->a2[t] = value;
+	}
+	
+	void stepRamps() {
+		if (rampLeft == 0) {
+			rampLeft = std::max(rampLength, 1);// start of a ramp, its targets were set at the boundary
+		}
+		rampLeft--;
+		for (int b = 0; b < 4; b++) {
+			if ((bandsRamping & (1 << b)) != 0) {
+				QuattroBiQuadCoeff& c = bandCoeffs[b];
+				if (rampLeft == 0) {
+					// end of the ramp, land exactly on the targets
+					c.b0 = bandTargets[b].b0;
+					c.b1 = bandTargets[b].b1;
+					c.b2 = bandTargets[b].b2;
+					c.a1 = bandTargets[b].a1;
+					c.a2 = bandTargets[b].a2;
+				}
+				else {
+					c.b0 += bandDeltas[b].b0;
+					c.b1 += bandDeltas[b].b1;
+					c.b2 += bandDeltas[b].b2;
+					c.a1 += bandDeltas[b].a1;
+					c.a2 += bandDeltas[b].a2;
+				}
+			}
+		}
+		if (rampLeft == 0) {
+			bandsRamping = 0;
+			gainsDifferentThanOne = targetGainsDifferentThanOne;// gains that ramped to 1 can now bypass their band
+		}
+	}
+	
+	
+	public:
+	
+	
+	void process(simd::float_4* outL, simd::float_4* outR, simd::float_4 inL, simd::float_4 inR) {
+		if (bandsRamping != 0) {
+			stepRamps();
+		}
+		
+		for (int b = 0; b < 4; b++) {
+			simd::float_4 yL;
+			simd::float_4 yR;
+			if ((gainsDifferentThanOne & (0xF << (b << 2))) != 0) {
+				const QuattroBiQuadCoeff& c = bandCoeffs[b];
+				yL = c.b0 * inL + c.b1 * x1L[b] + c.b2 * x2L[b] - c.a1 * x1L[b + 1] - c.a2 * x2L[b + 1];// https://en.wikipedia.org/wiki/Infinite_impulse_response
+				yR = c.b0 * inR + c.b1 * x1R[b] + c.b2 * x2R[b] - c.a1 * x1R[b + 1] - c.a2 * x2R[b + 1];
+			}
+			else {
+				// all four tracks are flat in this band: pass through, which keeps the shift registers as a flat biquad would have them
+				yL = inL;
+				yR = inR;
+			}
+			x2L[b] = x1L[b];
+			x1L[b] = inL;
+			x2R[b] = x1R[b];
+			x1R[b] = inR;
+			inL = yL;
+			inR = yR;
+		}
+		x2L[4] = x1L[4];
+		x1L[4] = inL;
+		x2R[4] = x1R[4];
+		x1R[4] = inR;
+		
+		*outL = inL * outGains;
+		*outR = inR * outGains;
+	}
+};